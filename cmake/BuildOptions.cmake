@@ -47,6 +47,12 @@ if( BIT7Z_DISABLE_USE_STD_FILESYSTEM )
     target_compile_definitions( ${LIB_TARGET} PUBLIC BIT7Z_DISABLE_USE_STD_FILESYSTEM )
 endif()
 
+option( BIT7Z_USE_STD_FILE_STREAMS "Enable or disable using std::fstream based streams for reading and writing files" )
+message( STATUS "Use std::fstream file streams: ${BIT7Z_USE_STD_FILE_STREAMS}" )
+if( BIT7Z_USE_STD_FILE_STREAMS )
+    target_compile_definitions( ${LIB_TARGET} PRIVATE BIT7Z_USE_STD_FILE_STREAMS )
+endif()
+
 set( BIT7Z_CUSTOM_7ZIP_PATH "" CACHE STRING "A custom path to the 7-zip source code" )
 if( NOT BIT7Z_CUSTOM_7ZIP_PATH STREQUAL "" )
     if( NOT EXISTS ${BIT7Z_CUSTOM_7ZIP_PATH}/CPP AND NOT EXISTS ${BIT7Z_CUSTOM_7ZIP_PATH}/DOC/readme.txt )
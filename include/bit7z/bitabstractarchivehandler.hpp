@@ -10,6 +10,7 @@
 #ifndef BITABSTRACTARCHIVEHANDLER_HPP
 #define BITABSTRACTARCHIVEHANDLER_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 
@@ -68,6 +69,46 @@ enum struct FilterPolicy {
     Exclude  ///< Do not extract/compress the items that match the pattern.
 };
 
+/**
+ * @brief Enumeration representing how the archive handler should access the archive files it reads.
+ */
+enum struct FileAccessMode {
+    Stream, ///< The archive file is read through a buffered file stream.
+    MemoryMapped ///< The archive file is mapped in memory, and read directly from the mapping.
+};
+
+/**
+ * @brief Enumeration representing the expected pattern with which the archive files will be read.
+ *
+ * @note The hint is forwarded to the operating system (e.g., via madvise on POSIX systems),
+ *       which may use it for tuning its read-ahead and caching policies.
+ */
+enum struct AccessPatternHint {
+    Normal, ///< No particular access pattern is expected.
+    Sequential, ///< The archive will be read mostly sequentially (e.g., when extracting the whole archive).
+    Random ///< The archive will be read mostly at random offsets (e.g., when extracting few items).
+};
+
+/**
+ * @brief The options used by an archive handler for reading archive files and extracting their content.
+ */
+struct ExtractionOptions {
+    /** @brief The size (in bytes) of the window for reading ahead the archive files (zero disables reading ahead). */
+    std::size_t readAheadWindowSize = 0;
+
+    /** @brief Whether the files extracted to the filesystem are written bypassing the OS page cache. */
+    bool unbuffered = false;
+
+    /** @brief Whether the disk space for the files extracted to the filesystem is preallocated. */
+    bool preallocateFiles = false;
+
+    /** @brief The number of threads used for extracting archives to the filesystem. */
+    std::size_t threads = 1;
+
+    /** @brief The number of threads writing the extracted files (zero makes the decoding thread write them). */
+    std::size_t writerThreads = 0;
+};
+
 /**
  * @brief Abstract class representing a generic archive handler.
  */
@@ -139,6 +180,22 @@ class BitAbstractArchiveHandler {
          */
         BIT7Z_NODISCARD auto overwriteMode() const -> OverwriteMode;
 
+        /**
+         * @return the current FileAccessMode.
+         */
+        BIT7Z_NODISCARD auto fileAccessMode() const noexcept -> FileAccessMode;
+
+        /**
+         * @return the current AccessPatternHint.
+         */
+        BIT7Z_NODISCARD auto accessPatternHint() const noexcept -> AccessPatternHint;
+
+        /**
+         * @return the options used by the handler when reading and extracting archives
+         *         (only archive openers let users change them).
+         */
+        BIT7Z_NODISCARD auto extractionOptions() const noexcept -> const ExtractionOptions&;
+
         /**
          * @brief Sets up a password to be used by the archive handler.
          *
@@ -225,16 +282,46 @@ class BitAbstractArchiveHandler {
          */
         void setOverwriteMode( OverwriteMode mode );
 
+        /**
+         * @brief Sets how the handler should access the archive files it opens from the filesystem.
+         *
+         * @note The setting affects only archives opened from a path;
+         *       multi-volume archives are always read through file streams.
+         *
+         * @note If an archive file cannot be mapped in memory (e.g., pipes and other special files,
+         *       or files larger than the address space of 32-bit processes), it is read through a file stream.
+         *
+         * @warning A memory-mapped archive file must not be truncated while it is open: reading the pages
+         *          past the new end of the file raises a SIGBUS signal on POSIX systems,
+         *          and an EXCEPTION_IN_PAGE_ERROR exception on Windows, neither of which can be reported
+         *          as a BitException.
+         *
+         * @param mode  the FileAccessMode to be used by the handler.
+         */
+        void setFileAccessMode( FileAccessMode mode ) noexcept;
+
+        /**
+         * @brief Sets the access pattern the handler should expect when reading memory-mapped archive files.
+         *
+         * @param hint  the AccessPatternHint to be used by the handler.
+         */
+        void setAccessPatternHint( AccessPatternHint hint ) noexcept;
+
     protected:
         explicit BitAbstractArchiveHandler( const Bit7zLibrary& lib,
                                             tstring password = {},
                                             OverwriteMode overwriteMode = OverwriteMode::None );
 
+        void setExtractionOptions( const ExtractionOptions& options ) noexcept;
+
     private:
         const Bit7zLibrary& mLibrary;
         tstring mPassword;
         bool mRetainDirectories;
         OverwriteMode mOverwriteMode;
+        FileAccessMode mFileAccessMode;
+        AccessPatternHint mAccessPatternHint;
+        ExtractionOptions mExtractionOptions;
 
         //CALLBACKS
         TotalCallback mTotalCallback;
@@ -45,6 +45,115 @@ class BitAbstractArchiveOpener : public BitAbstractArchiveHandler {
          */
         BIT7Z_NODISCARD auto extractionFormat() const noexcept -> const BitInFormat&;
 
+        /**
+         * @return the size (in bytes) of the window used for reading ahead the archive files
+         *         (zero if reading ahead is disabled).
+         */
+        BIT7Z_NODISCARD auto readAheadWindowSize() const noexcept -> std::size_t;
+
+        /**
+         * @brief Sets the size of the window used for reading ahead the archive files opened from the filesystem.
+         *
+         * When the window size is greater than zero, archive files are read in windows of the given size and,
+         * while the current window is consumed sequentially (e.g., by the decoder during an extraction),
+         * the next one is read in the background by a helper thread.
+         *
+         * @note Reading ahead is not used for memory-mapped archive files (see FileAccessMode).
+         *
+         * @param windowSize  the size (in bytes) of the read-ahead window; zero disables reading ahead.
+         */
+        void setReadAheadWindowSize( std::size_t windowSize ) noexcept;
+
+        /**
+         * @return whether the files extracted to the filesystem are written bypassing the OS page cache.
+         */
+        BIT7Z_NODISCARD auto unbufferedExtraction() const noexcept -> bool;
+
+        /**
+         * @brief Sets whether the files extracted to the filesystem must be written bypassing the OS page cache
+         *        (i.e., using O_DIRECT on Linux, F_NOCACHE on macOS, and FILE_FLAG_NO_BUFFERING on Windows).
+         *
+         * Unbuffered extraction is useful for bulk extractions of large amounts of data, which would otherwise
+         * fill the page cache, evicting the data used by other processes.
+         * Extracted data is written in large aligned blocks, while the (unaligned) tail of each file
+         * is written normally.
+         *
+         * @note If the output filesystem doesn't support unbuffered I/O, files are written normally.
+         *
+         * @note This setting has no effect when bit7z is built with the `BIT7Z_USE_STD_FILE_STREAMS` option.
+         *
+         * @param unbuffered  whether to bypass the OS page cache when extracting files.
+         */
+        void setUnbufferedExtraction( bool unbuffered ) noexcept;
+
+        /**
+         * @return whether the disk space for the files extracted to the filesystem is preallocated.
+         */
+        BIT7Z_NODISCARD auto preallocateExtractedFiles() const noexcept -> bool;
+
+        /**
+         * @brief Sets whether the disk space for the files extracted to the filesystem must be preallocated,
+         *        using the sizes of the items declared by the archive.
+         *
+         * Preallocating the disk space (e.g., via fallocate on Linux) reduces the fragmentation of large
+         * extracted files, as well as the filesystem metadata updates needed while writing them.
+         *
+         * @note Preallocation is only a hint: if the output filesystem doesn't support it, files are written normally.
+         *
+         * @param preallocate  whether to preallocate the disk space of the extracted files.
+         */
+        void setPreallocateExtractedFiles( bool preallocate ) noexcept;
+
+        /**
+         * @return the number of threads used for extracting archives to the filesystem.
+         */
+        BIT7Z_NODISCARD auto extractionThreads() const noexcept -> std::size_t;
+
+        /**
+         * @brief Sets the number of threads to be used for extracting archives to the filesystem.
+         *
+         * When more than one thread is used, the items to be extracted are split among several workers,
+         * each one decoding its items through its own instance of the archive, opened on an independent input
+         * stream; the extracted files are written to the same output directory as in a normal extraction.
+         *
+         * During a parallel extraction, the progress reported to the callbacks is the overall one of all
+         * the workers, and the calls to the callbacks are serialized (though they might come from different
+         * threads).
+         *
+         * Items belonging to the same solid block are always extracted by the same worker, so solid archives
+         * (e.g., 7z archives with multiple solid blocks) use at most one thread per solid block.
+         *
+         * @note Parallel extraction is used only for archives opened from the filesystem or from a memory buffer;
+         *       archives opened from standard streams are always extracted by a single thread.
+         *
+         * @param threadsCount  the number of extraction threads; values lower than two disable parallel extraction.
+         */
+        void setExtractionThreads( std::size_t threadsCount ) noexcept;
+
+        /**
+         * @return the number of threads writing the files extracted to the filesystem.
+         */
+        BIT7Z_NODISCARD auto extractionWriterThreads() const noexcept -> std::size_t;
+
+        /**
+         * @brief Sets the number of threads to be used for writing the files extracted to the filesystem.
+         *
+         * By default (zero writer threads), the thread decoding the archive also does all the filesystem work
+         * (creating folders, opening and writing files, setting their attributes and times).
+         * When using writer threads, the decoder only copies the extracted data into in-memory chunks,
+         * while the writer threads do the filesystem work; the amount of memory used by the pending chunks
+         * is bounded, so the decoder waits for the writers whenever they fall too far behind.
+         *
+         * This is especially useful when extracting archives with many small files, where the decoder
+         * would otherwise spend most of its time blocked in filesystem calls.
+         *
+         * @note When using writer threads, errors occurring while writing a file (e.g., when the file already
+         *       exists and the OverwriteMode is None) might be reported after other files have been extracted.
+         *
+         * @param threadsCount  the number of writer threads; zero makes the decoding thread write the files.
+         */
+        void setExtractionWriterThreads( std::size_t threadsCount ) noexcept;
+
     protected:
         BitAbstractArchiveOpener( const Bit7zLibrary& lib,
                                   const BitInFormat& format,
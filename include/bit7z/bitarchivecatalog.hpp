@@ -0,0 +1,140 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BITARCHIVECATALOG_HPP
+#define BITARCHIVECATALOG_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "bitdefines.hpp"
+#include "bitpropvariant.hpp"
+#include "bittypes.hpp"
+
+namespace bit7z {
+
+class BitInputArchive;
+
+/**
+ * @brief The BitArchiveCatalog class is a compact, in-memory snapshot of the metadata of all the items
+ * in an archive.
+ *
+ * The metadata is stored as a struct of arrays: each fixed-width property (e.g., size, CRC, attributes, times)
+ * is kept in its own contiguous column, while the names of all the items and directories are stored
+ * in a single string pool, with each directory prefix shared among all the items it contains.
+ *
+ * @note All the item accessors take the index of the item in the archive, and throw a BitException
+ *       (with the BitError::InvalidIndex error code) if the index is not valid.
+ */
+class BitArchiveCatalog final {
+    public:
+        /**
+         * @brief Constructs a BitArchiveCatalog by reading the metadata of all the items in the given archive.
+         *
+         * @param archive  the archive whose items must be cataloged.
+         */
+        explicit BitArchiveCatalog( const BitInputArchive& archive );
+
+        /**
+         * @return the number of items in the catalog.
+         */
+        BIT7Z_NODISCARD auto itemsCount() const noexcept -> uint32_t;
+
+        /**
+         * @return the path of the item at the given index.
+         */
+        BIT7Z_NODISCARD auto path( uint32_t index ) const -> tstring;
+
+        /**
+         * @return the name (i.e., the last path component) of the item at the given index.
+         */
+        BIT7Z_NODISCARD auto name( uint32_t index ) const -> tstring;
+
+        /**
+         * @return true if and only if the item at the given index is a directory.
+         */
+        BIT7Z_NODISCARD auto isDir( uint32_t index ) const -> bool;
+
+        /**
+         * @return true if and only if the item at the given index is encrypted.
+         */
+        BIT7Z_NODISCARD auto isEncrypted( uint32_t index ) const -> bool;
+
+        /**
+         * @return the uncompressed size of the item at the given index (or 0 if not available).
+         */
+        BIT7Z_NODISCARD auto size( uint32_t index ) const -> uint64_t;
+
+        /**
+         * @return the compressed size of the item at the given index (or 0 if not available).
+         */
+        BIT7Z_NODISCARD auto packSize( uint32_t index ) const -> uint64_t;
+
+        /**
+         * @return the CRC of the item at the given index (or 0 if not available).
+         */
+        BIT7Z_NODISCARD auto crc( uint32_t index ) const -> uint32_t;
+
+        /**
+         * @return the attributes of the item at the given index (or 0 if not available).
+         */
+        BIT7Z_NODISCARD auto attributes( uint32_t index ) const -> uint32_t;
+
+        /**
+         * @return the creation time of the item at the given index, or the current time if not available.
+         */
+        BIT7Z_NODISCARD auto creationTime( uint32_t index ) const -> time_type;
+
+        /**
+         * @return the last access time of the item at the given index, or the current time if not available.
+         */
+        BIT7Z_NODISCARD auto lastAccessTime( uint32_t index ) const -> time_type;
+
+        /**
+         * @return the last write time of the item at the given index, or the current time if not available.
+         */
+        BIT7Z_NODISCARD auto lastWriteTime( uint32_t index ) const -> time_type;
+
+    private:
+        struct StringRef {
+            uint32_t offset;
+            uint32_t size;
+        };
+
+        struct Directory {
+            uint32_t parent;
+            StringRef name;
+        };
+
+        tstring mStringPool;
+        std::vector< Directory > mDirectories;
+        std::vector< uint32_t > mParents;
+        std::vector< StringRef > mNames;
+        std::vector< uint64_t > mSizes;
+        std::vector< uint64_t > mPackSizes;
+        std::vector< uint32_t > mCrcs;
+        std::vector< uint32_t > mAttributes;
+        std::vector< uint64_t > mCreationTimes;
+        std::vector< uint64_t > mAccessTimes;
+        std::vector< uint64_t > mWriteTimes;
+        std::vector< uint8_t > mFlags;
+
+        auto internString( const tchar* str, std::size_t size ) -> StringRef;
+
+        void checkIndex( uint32_t index ) const;
+
+        BIT7Z_NODISCARD auto pooledString( StringRef ref ) const -> tstring;
+
+        BIT7Z_NODISCARD auto itemTime( const std::vector< uint64_t >& column, uint32_t index, uint8_t flag ) const
+            -> time_type;
+};
+
+}  // namespace bit7z
+
+#endif // BITARCHIVECATALOG_HPP
@@ -98,7 +98,7 @@ class BIT7Z_MAYBE_UNUSED BitArchiveEditor final : public BitArchiveWriter {
          * @param index     the index of the item to be updated.
          * @param inBuffer  the buffer containing the new data for the item.
          */
-        void updateItem( uint32_t index, const std::vector< byte_t >& inBuffer );
+        void updateItem( uint32_t index, BufferView inBuffer );
 
         /**
          * @brief Requests to update the content of the item at the specified index
@@ -125,7 +125,7 @@ class BIT7Z_MAYBE_UNUSED BitArchiveEditor final : public BitArchiveWriter {
          * @param itemPath  the path (in the archive) of the item to be updated.
          * @param inBuffer  the buffer containing the new data for the item.
          */
-        void updateItem( const tstring& itemPath, const std::vector< byte_t >& inBuffer );
+        void updateItem( const tstring& itemPath, BufferView inBuffer );
 
         /**
          * @brief Requests to update the content of the item at the specified path
@@ -10,7 +10,11 @@
 #ifndef BITARCHIVEITEMINFO_HPP
 #define BITARCHIVEITEMINFO_HPP
 
+#include <array>
+#include <bitset>
+#include <cstdint>
 #include <map>
+#include <vector>
 
 #include "bitarchiveitem.hpp"
 
@@ -21,6 +25,9 @@ using std::map;
 
 /**
  * @brief The BitArchiveItemInfo class represents an archived item and that stores all its properties for later use.
+ *
+ * @note The properties are stored in a fixed slot for each BitProperty (rather than in a map),
+ *       so that looking them up doesn't need any tree traversal.
  */
 class BitArchiveItemInfo final : public BitArchiveItem {
     public:
@@ -39,7 +46,13 @@ class BitArchiveItemInfo final : public BitArchiveItem {
         BIT7Z_NODISCARD auto itemProperties() const -> map< BitProperty, BitPropVariant >;
 
     private:
-        map< BitProperty, BitPropVariant > mItemProperties;
+        static constexpr std::size_t kPropertiesCount = static_cast< std::size_t >( BitProperty::CopyLink ) + 1;
+
+        std::bitset< kPropertiesCount > mAvailableProperties;
+
+        // The position of each available property's value in mValues.
+        std::array< uint8_t, kPropertiesCount > mSlots;
+        std::vector< BitPropVariant > mValues;
 
         /* BitArchiveItem objects can be created and updated only by BitArchiveReader */
         explicit BitArchiveItemInfo( uint32_t itemIndex );
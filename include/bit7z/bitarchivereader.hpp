@@ -10,7 +10,10 @@
 #ifndef BITARCHIVEREADER_HPP
 #define BITARCHIVEREADER_HPP
 
+#include <mutex>
+
 #include "bitabstractarchiveopener.hpp"
+#include "bitarchivecatalog.hpp"
 #include "bitarchiveiteminfo.hpp"
 #include "bitexception.hpp"
 #include "bitinputarchive.hpp"
@@ -21,6 +24,26 @@ struct IArchiveExtractCallback;
 
 namespace bit7z {
 
+/**
+ * @brief A column of values of an item property, containing a value for each item in an archive.
+ *
+ * @note The values are variants since the actual type of a property depends on the archive format
+ *       (e.g., the same property might be a 32-bit integer in some formats and a 64-bit one in others).
+ */
+using BitPropertyColumn = vector< BitPropVariant >;
+
+/**
+ * @brief The aggregate information about the items of an archive, computed in a single pass over the items.
+ */
+struct BitArchiveSummary {
+    uint32_t foldersCount;   ///< The number of folders contained in the archive.
+    uint32_t filesCount;     ///< The number of files contained in the archive.
+    uint64_t size;           ///< The total uncompressed size of the archive content.
+    uint64_t packSize;       ///< The total compressed size of the archive content.
+    bool hasEncryptedItems;  ///< Whether the archive has at least one encrypted file.
+    bool isEncrypted;        ///< Whether the archive has files and all of them are encrypted.
+};
+
 /**
  * @brief The BitArchiveReader class allows reading metadata of archives, as well as extracting them.
  */
@@ -58,7 +81,7 @@ class BitArchiveReader final : public BitAbstractArchiveOpener, public BitInputA
          * @param password      the password needed for opening the input archive.
          */
         BitArchiveReader( const Bit7zLibrary& lib,
-                          const std::vector< byte_t >& inArchive,
+                          BufferView inArchive,
                           const BitInFormat& format BIT7Z_DEFAULT_FORMAT,
                           const tstring& password = {} );
 
@@ -105,6 +128,37 @@ class BitArchiveReader final : public BitAbstractArchiveOpener, public BitInputA
          */
         BIT7Z_NODISCARD auto items() const -> vector< BitArchiveItemInfo >;
 
+        /**
+         * @brief Retrieves only the given properties of all the archive items, arranged in columns.
+         *
+         * Unlike items(), which probes every possible property of each item, this function reads
+         * only the requested properties, making it much faster for listing archives with many items.
+         *
+         * @param properties  the item properties to be retrieved.
+         *
+         * @return a column for each requested property (in the same order); the i-th value in each column
+         *         is the value of the property for the item at index i (or an empty BitPropVariant, if the item
+         *         has no value for the property).
+         */
+        BIT7Z_NODISCARD auto itemsProperties( const vector< BitProperty >& properties ) const
+            -> vector< BitPropertyColumn >;
+
+        /**
+         * @brief Retrieves the aggregate information about the archive items.
+         *
+         * The summary is computed by reading the items only once, and it is cached by the reader,
+         * so that the following calls to this function (and to foldersCount(), filesCount(), size(), packSize(),
+         * hasEncryptedItems(), and isEncrypted()) don't read the items again.
+         *
+         * @return the summary of the archive items.
+         */
+        BIT7Z_NODISCARD auto summary() const -> BitArchiveSummary;
+
+        /**
+         * @brief Discards the cached summary of the archive items, so that it is recomputed on the next use.
+         */
+        void invalidateSummary() noexcept;
+
         /**
          * @return the number of folders contained in the archive.
          */
@@ -204,6 +258,10 @@ class BitArchiveReader final : public BitAbstractArchiveOpener, public BitInputA
         }
 
     private:
+        mutable BitArchiveSummary mSummary;
+        mutable bool mSummaryValid;
+        mutable std::mutex mSummaryMutex;
+
         static auto isOpenEncryptedError( std::error_code error ) -> bool;
 };
 
@@ -49,7 +49,7 @@ class BitArchiveWriter : public BitAbstractArchiveCreator, public BitOutputArchi
          * @param password      (optional) the password needed to read the input archive.
          */
         BitArchiveWriter( const Bit7zLibrary& lib,
-                          const std::vector< byte_t >& inArchive,
+                          BufferView inArchive,
                           const BitInOutFormat& format,
                           const tstring& password = {} );
 
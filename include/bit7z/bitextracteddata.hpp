@@ -0,0 +1,118 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BITEXTRACTEDDATA_HPP
+#define BITEXTRACTEDDATA_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "bitdefines.hpp"
+#include "bittypes.hpp"
+
+namespace bit7z {
+
+class BitInputArchive;
+
+/**
+ * @brief The BitExtractedData class holds the content of the files extracted to memory from an archive.
+ *
+ * All the file contents are stored in a single contiguous buffer (the arena), and all the paths in a single
+ * string pool, while a flat index sorted by path maps each file to its content in the arena.
+ * Hence, extracting many small files costs only a handful of memory allocations.
+ */
+class BitExtractedData final {
+    public:
+        /**
+         * @return the number of files contained in the extracted data.
+         */
+        BIT7Z_NODISCARD auto size() const noexcept -> std::size_t;
+
+        /**
+         * @return true if no file was extracted, false otherwise.
+         */
+        BIT7Z_NODISCARD auto empty() const noexcept -> bool;
+
+        /**
+         * @brief Finds the file with the given path (inside the archive).
+         *
+         * @param path  the path of the file to be found.
+         *
+         * @return the position of the file in the (path-sorted) index, or size() if there's no such file.
+         */
+        BIT7Z_NODISCARD auto find( const tstring& path ) const -> std::size_t;
+
+        /**
+         * @param path  the path of the file to be searched.
+         *
+         * @return true if the extracted data contains a file with the given path, false otherwise.
+         */
+        BIT7Z_NODISCARD auto contains( const tstring& path ) const -> bool;
+
+        /**
+         * @param position  the position of the file in the (path-sorted) index.
+         *
+         * @return the path of the file (inside the archive).
+         */
+        BIT7Z_NODISCARD auto path( std::size_t position ) const -> tstring;
+
+        /**
+         * @param position  the position of the file in the (path-sorted) index.
+         *
+         * @return the index of the file inside the archive.
+         */
+        BIT7Z_NODISCARD auto index( std::size_t position ) const -> uint32_t;
+
+        /**
+         * @param position  the position of the file in the (path-sorted) index.
+         *
+         * @return a pointer to the content of the file inside the arena.
+         */
+        BIT7Z_NODISCARD auto data( std::size_t position ) const -> const byte_t*;
+
+        /**
+         * @param position  the position of the file in the (path-sorted) index.
+         *
+         * @return the size of the content of the file.
+         */
+        BIT7Z_NODISCARD auto dataSize( std::size_t position ) const -> std::size_t;
+
+        /**
+         * @return the buffer containing the contents of all the extracted files.
+         */
+        BIT7Z_NODISCARD auto arena() const noexcept -> const std::vector< byte_t >&;
+
+        /**
+         * @brief Removes all the extracted files, releasing the used memory.
+         */
+        void clear() noexcept;
+
+    private:
+        struct Entry {
+            uint32_t index;
+            std::size_t pathOffset;
+            std::size_t pathSize;
+            std::size_t dataOffset;
+            std::size_t dataSize;
+        };
+
+        std::vector< byte_t > mArena;
+        tstring mPaths;
+        std::vector< Entry > mEntries;
+
+        BIT7Z_NODISCARD auto comparePath( const Entry& entry, const tstring& path ) const noexcept -> int;
+
+        BIT7Z_NODISCARD auto comparePaths( const Entry& first, const Entry& second ) const noexcept -> int;
+
+        friend class BitInputArchive;
+};
+
+}  // namespace bit7z
+
+#endif // BITEXTRACTEDDATA_HPP
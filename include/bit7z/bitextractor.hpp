@@ -86,6 +86,18 @@ class BitExtractor final : public BitAbstractArchiveOpener {
             inputArchive.extractTo( outStream, index );
         }
 
+        /**
+         * @brief Extracts the specified files from the given archive to their pre-allocated output buffers,
+         * in a single pass over the archive.
+         *
+         * @param inArchive    the input archive to extract from.
+         * @param itemBuffers  the items to be extracted, each one with its pre-allocated output buffer.
+         */
+        void extract( Input inArchive, const std::vector< ItemBuffer >& itemBuffers ) const {
+            BitInputArchive inputArchive( *this, inArchive );
+            inputArchive.extractTo( itemBuffers );
+        }
+
         /**
          * @brief Extracts the content of the given archive into a map of memory buffers, where the keys are
          * the paths of the files (inside the archive), and the values are their decompressed contents.
@@ -98,6 +110,31 @@ class BitExtractor final : public BitAbstractArchiveOpener {
             inputArchive.extractTo( outMap );
         }
 
+        /**
+         * @brief Extracts the content of the given archive to memory, storing all the files in a single
+         * contiguous buffer indexed by their paths (inside the archive).
+         *
+         * @param inArchive    the input archive to be extracted.
+         * @param outData      the output extracted data.
+         */
+        void extract( Input inArchive, BitExtractedData& outData ) const {
+            BitInputArchive inputArchive( *this, inArchive );
+            inputArchive.extractTo( outData );
+        }
+
+        /**
+         * @brief Extracts the content of the specified items of the given archive to the sink callbacks,
+         * which receive the extracted data without any intermediate buffer.
+         *
+         * @param inArchive    the input archive to extract from.
+         * @param sink         the callbacks receiving the extracted data.
+         * @param indices      the indices of the items to be extracted (if empty, all the files are extracted).
+         */
+        void extract( Input inArchive, const ExtractSink& sink, const std::vector< uint32_t >& indices = {} ) const {
+            BitInputArchive inputArchive( *this, inArchive );
+            inputArchive.extractTo( sink, indices );
+        }
+
         /**
          * @brief Extracts the files in the archive that match the given wildcard pattern to the chosen directory.
          *
@@ -145,6 +182,33 @@ class BitExtractor final : public BitAbstractArchiveOpener {
                                    } );
         }
 
+        /**
+         * @brief Extracts all the files in the archive matching the given wildcard pattern into a map of memory
+         * buffers, where the keys are the paths of the files (inside the archive), and the values are their
+         * decompressed contents.
+         *
+         * @note The archive is opened only once, and all the files are extracted in a single pass over it.
+         *
+         * @param inArchive    the input archive to extract from.
+         * @param itemFilter   the wildcard pattern used for matching the paths of files inside the archive.
+         * @param outMap       the output map.
+         * @param policy       the filtering policy to be applied to the matched items.
+         */
+        void extractMatching( Input inArchive,
+                              const tstring& itemFilter,
+                              std::map< tstring, vector< byte_t > >& outMap,
+                              FilterPolicy policy = FilterPolicy::Include ) const {
+            using namespace filesystem;
+
+            if ( itemFilter.empty() ) {
+                throw BitException( "Cannot extract items", make_error_code( BitError::FilterNotSpecified ) );
+            }
+
+            extractMatchingFilter( inArchive, outMap, policy, [ &itemFilter ]( const tstring& itemPath ) -> bool {
+                return fsutil::wildcard_match( itemFilter, itemPath );
+            } );
+        }
+
         /**
          * @brief Extracts the specified items from the given archive to the chosen directory.
          *
@@ -163,6 +227,27 @@ class BitExtractor final : public BitAbstractArchiveOpener {
             inputArchive.extractTo( outDir, indices );
         }
 
+        /**
+         * @brief Extracts the specified files from the given archive into a map of memory buffers, where the keys
+         * are the paths of the files (inside the archive), and the values are their decompressed contents.
+         *
+         * @note The archive is opened only once, and all the files are extracted in a single pass over it.
+         *
+         * @param inArchive    the input archive to extract from.
+         * @param indices      the indices of the files in the archive that should be extracted.
+         * @param outMap       the output map.
+         */
+        void extractItems( Input inArchive,
+                           const std::vector< uint32_t >& indices,
+                           std::map< tstring, vector< byte_t > >& outMap ) const {
+            if ( indices.empty() ) {
+                throw BitException( "Cannot extract items", make_error_code( BitError::IndicesNotSpecified ) );
+            }
+
+            BitInputArchive inputArchive( *this, inArchive );
+            inputArchive.extractTo( outMap, indices );
+        }
+
 #ifdef BIT7Z_REGEX_MATCHING
 
         /**
@@ -214,6 +299,32 @@ class BitExtractor final : public BitAbstractArchiveOpener {
                                           } );
         }
 
+        /**
+         * @brief Extracts all the files in the archive matching the given regex pattern into a map of memory
+         * buffers, where the keys are the paths of the files (inside the archive), and the values are their
+         * decompressed contents.
+         *
+         * @note Available only when compiling bit7z using the BIT7Z_REGEX_MATCHING preprocessor define.
+         *
+         * @param inArchive    the input archive to extract from.
+         * @param regex        the regex used for matching the paths of files inside the archive.
+         * @param outMap       the output map.
+         * @param policy       the filtering policy to be applied to the matched items.
+         */
+        void extractMatchingRegex( Input inArchive,
+                                   const tstring& regex,
+                                   std::map< tstring, vector< byte_t > >& outMap,
+                                   FilterPolicy policy = FilterPolicy::Include ) const {
+            if ( regex.empty() ) {
+                throw BitException( "Cannot extract items", make_error_code( BitError::FilterNotSpecified ) );
+            }
+
+            const tregex regexFilter( regex, tregex::ECMAScript | tregex::optimize );
+            extractMatchingFilter( inArchive, outMap, policy, [ &regexFilter ]( const tstring& itemPath ) -> bool {
+                return std::regex_match( itemPath, regexFilter );
+            } );
+        }
+
 #endif
 
         /**
@@ -229,16 +340,18 @@ class BitExtractor final : public BitAbstractArchiveOpener {
         }
 
     private:
-        void extractMatchingFilter( Input inArchive,
-                                    const tstring& outDir,
-                                    FilterPolicy policy,
-                                    const std::function< bool( const tstring& ) >& filter ) const {
-            BitInputArchive inputArchive( *this, inArchive );
-
+        static auto matchingIndices( const BitInputArchive& inputArchive,
+                                     FilterPolicy policy,
+                                     const std::function< bool( const tstring& ) >& filter,
+                                     bool filesOnly ) -> vector< uint32_t > {
             vector< uint32_t > matchedIndices;
             const bool shouldExtractMatchedItems = policy == FilterPolicy::Include;
             // Searching for files inside the archive that match the given filter
             for ( const auto& item : inputArchive ) {
+                if ( filesOnly && item.isDir() ) {
+                    continue;
+                }
+
                 const bool itemMatches = filter( item.path() );
                 if ( itemMatches == shouldExtractMatchedItems ) {
                     /* The if-condition is equivalent to an exclusive XNOR (negated XOR) between
@@ -253,8 +366,23 @@ class BitExtractor final : public BitAbstractArchiveOpener {
             if ( matchedIndices.empty() ) {
                 throw BitException( "Cannot extract items", make_error_code( BitError::NoMatchingItems ) );
             }
+            return matchedIndices;
+        }
+
+        void extractMatchingFilter( Input inArchive,
+                                    const tstring& outDir,
+                                    FilterPolicy policy,
+                                    const std::function< bool( const tstring& ) >& filter ) const {
+            BitInputArchive inputArchive( *this, inArchive );
+            inputArchive.extractTo( outDir, matchingIndices( inputArchive, policy, filter, false ) );
+        }
 
-            inputArchive.extractTo( outDir, matchedIndices );
+        void extractMatchingFilter( Input inArchive,
+                                    std::map< tstring, vector< byte_t > >& outMap,
+                                    FilterPolicy policy,
+                                    const std::function< bool( const tstring& ) >& filter ) const {
+            BitInputArchive inputArchive( *this, inArchive );
+            inputArchive.extractTo( outMap, matchingIndices( inputArchive, policy, filter, true ) );
         }
 
         void extractMatchingFilter( Input inArchive,
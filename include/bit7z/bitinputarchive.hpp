@@ -10,10 +10,14 @@
 #define BITINPUTARCHIVE_HPP
 
 #include <array>
+#include <functional>
 #include <map>
+#include <mutex>
+#include <unordered_map>
 
 #include "bitabstractarchivehandler.hpp"
 #include "bitarchiveitemoffset.hpp"
+#include "bitextracteddata.hpp"
 #include "bitformat.hpp"
 #include "bitfs.hpp"
 
@@ -25,6 +29,45 @@ namespace bit7z {
 
 using std::vector;
 
+class AsyncWriterPool;
+
+/**
+ * @brief A std::function whose argument is the index of the archive item whose data is about to be extracted.
+ */
+using ItemBeginCallback = std::function< void( uint32_t ) >;
+
+/**
+ * @brief A std::function whose arguments are the index of the archive item being extracted and a chunk
+ * of its data (as produced by the decoder), and which returns true if the extraction should continue,
+ * false otherwise.
+ */
+using ItemDataCallback = std::function< bool( uint32_t, const byte_t*, std::size_t ) >;
+
+/**
+ * @brief A std::function whose arguments are the index of the archive item whose extraction has ended,
+ * and whether the item was extracted successfully.
+ */
+using ItemEndCallback = std::function< void( uint32_t, bool ) >;
+
+/**
+ * @brief The ExtractSink struct groups the callbacks receiving the content of the extracted items,
+ * without any intermediate buffer.
+ */
+struct ExtractSink {
+    ItemBeginCallback onItemBegin; ///< Called before the data of each extracted item (optional).
+    ItemDataCallback onData; ///< Called for each chunk of data of the extracted items (required).
+    ItemEndCallback onItemEnd; ///< Called after the data of each extracted item (optional).
+};
+
+/**
+ * @brief The ItemBuffer struct represents a pre-allocated output buffer for the item at the given index.
+ */
+struct ItemBuffer {
+    uint32_t index; ///< The index of the item to be extracted.
+    byte_t* buffer; ///< The pre-allocated output buffer (it can be null for empty items).
+    std::size_t size; ///< The size of the output buffer (it must be equal to the unpacked size of the item).
+};
+
 /**
  * @brief The BitInputArchive class, given a handler object, allows reading/extracting the content of archives.
  */
@@ -51,11 +94,25 @@ class BitInputArchive {
         /**
          * @brief Constructs a BitInputArchive object, opening the archive given in the input buffer.
          *
+         * @note The buffer is not copied: it must remain valid for the whole lifetime of the object.
+         *
          * @param handler  the reference to the BitAbstractArchiveHandler object containing all the settings to
          *                 be used for reading the input archive
          * @param inBuffer the buffer containing the input archive
          */
-        BitInputArchive( const BitAbstractArchiveHandler& handler, const std::vector< byte_t >& inBuffer );
+        BitInputArchive( const BitAbstractArchiveHandler& handler, BufferView inBuffer );
+
+        /**
+         * @brief Constructs a BitInputArchive object, opening the archive stored in the given memory region.
+         *
+         * @note The memory region is not copied: it must remain valid for the whole lifetime of the object.
+         *
+         * @param handler  the reference to the BitAbstractArchiveHandler object containing all the settings to
+         *                 be used for reading the input archive
+         * @param inData   the pointer to the first byte of the input archive
+         * @param size     the size (in bytes) of the input archive
+         */
+        BitInputArchive( const BitAbstractArchiveHandler& handler, const byte_t* inData, std::size_t size );
 
         /**
          * @brief Constructs a BitInputArchive object, opening the archive by reading the given input stream.
@@ -101,6 +158,11 @@ class BitInputArchive {
          */
         BIT7Z_NODISCARD auto itemProperty( uint32_t index, BitProperty property ) const -> BitPropVariant;
 
+        /**
+         * @return the item properties that the archive format declares as available for the archive's items.
+         */
+        BIT7Z_NODISCARD auto availableItemProperties() const -> std::vector< BitProperty >;
+
         /**
          * @return the number of items contained in the archive.
          */
@@ -216,6 +278,16 @@ class BitInputArchive {
          */
         void extractTo( byte_t* buffer, std::size_t size, uint32_t index = 0 ) const;
 
+        /**
+         * @brief Extracts the specified files to their pre-allocated output buffers, in a single pass
+         * over the archive.
+         *
+         * @note Unlike calling the single buffer overload for each item, solid blocks are decoded only once.
+         *
+         * @param itemBuffers the items to be extracted, each one with its pre-allocated output buffer.
+         */
+        void extractTo( const std::vector< ItemBuffer >& itemBuffers ) const;
+
         BIT7Z_DEPRECATED_MSG("Since v4.0; please, use the extractTo method.")
         inline void extract( std::ostream& outStream, uint32_t index = 0 ) const {
             extractTo( outStream, index );
@@ -229,6 +301,24 @@ class BitInputArchive {
          */
         void extractTo( std::ostream& outStream, uint32_t index = 0 ) const;
 
+        /**
+         * @brief Extracts a byte range of the content of a file to the output buffer.
+         *
+         * The data before the range is discarded without being buffered, and the extraction stops as soon
+         * as the range has been filled; when the archive format allows it (e.g., for stored items),
+         * the range is read directly, without decoding the data preceding it.
+         *
+         * @param index      the index of the file to be extracted.
+         * @param offset     the offset of the range inside the content of the file.
+         * @param length     the length of the range.
+         * @param outBuffer  the output buffer; it will be shorter than the given length
+         *                   if the range exceeds the end of the file.
+         */
+        void extractRange( uint32_t index,
+                           uint64_t offset,
+                           std::size_t length,
+                           std::vector< byte_t >& outBuffer ) const;
+
         BIT7Z_DEPRECATED_MSG("Since v4.0; please, use the extractTo method.")
         inline void extract( std::map< tstring, std::vector< byte_t > >& outMap ) const {
             extractTo( outMap );
@@ -242,6 +332,43 @@ class BitInputArchive {
          */
         void extractTo( std::map< tstring, std::vector< byte_t > >& outMap ) const;
 
+        /**
+         * @brief Extracts the specified files to a map of memory buffers, where the keys are the paths
+         * of the files (inside the archive), and the values are their decompressed contents.
+         *
+         * @note All the files are extracted in a single pass over the archive.
+         *
+         * @param outMap   the output map.
+         * @param indices  the indices of the files to be extracted (if empty, all the files are extracted).
+         */
+        void extractTo( std::map< tstring, std::vector< byte_t > >& outMap,
+                        const std::vector< uint32_t >& indices ) const;
+
+        /**
+         * @brief Extracts the content of the archive to memory, storing all the files in a single contiguous
+         * buffer indexed by their paths (inside the archive).
+         *
+         * @note Unlike the map-based overload, this requires only a handful of memory allocations,
+         *       regardless of the number of extracted files.
+         *
+         * @param outData  the output extracted data (its previous content is discarded).
+         */
+        void extractTo( BitExtractedData& outData ) const;
+
+        /**
+         * @brief Extracts the content of the specified items to the given sink callbacks.
+         *
+         * The data chunks are passed to the sink exactly as the decoder produces them, without being copied
+         * into any intermediate buffer; hence, they are valid only until the data callback returns.
+         *
+         * @note The extraction can be stopped by returning false from the data callback; if any of the sink
+         *       callbacks throws an exception, the extraction is stopped, and the exception is rethrown to the caller.
+         *
+         * @param sink     the callbacks receiving the extracted data.
+         * @param indices  the indices of the items to be extracted (if empty, all the files are extracted).
+         */
+        void extractTo( const ExtractSink& sink, const std::vector< uint32_t >& indices = {} ) const;
+
         /**
          * @brief Tests the archive without extracting its content.
          *
@@ -274,9 +401,27 @@ class BitInputArchive {
         const BitInFormat* mDetectedFormat;
         const BitAbstractArchiveHandler& mArchiveHandler;
         tstring mArchivePath;
+        BufferView mArchiveBuffer;
+
+        // Index of the items' paths, lazily built on the first lookup by path (see find()).
+        mutable std::unordered_map< tstring, uint32_t > mPathIndex;
+        mutable std::mutex mPathIndexMutex;
+        mutable bool mPathIndexBuilt;
 
         auto openArchiveStream( const fs::path& name, IInStream* inStream ) -> IInArchive*;
 
+        BIT7Z_NODISCARD auto readRange( uint32_t index,
+                                        uint64_t offset,
+                                        std::size_t length,
+                                        std::vector< byte_t >& outBuffer ) const -> bool;
+
+        BIT7Z_NODISCARD auto parallelExtractionThreads( std::size_t itemsCount ) const -> std::size_t;
+
+        void extractParallel( const tstring& outDir,
+                              const std::vector< uint32_t >& indices,
+                              std::size_t threadsCount,
+                              AsyncWriterPool* writerPool ) const;
+
     public:
         /**
          * @brief An iterator for the elements contained in an archive.
@@ -373,6 +518,11 @@ class BitInputArchive {
         /**
          * @brief Find an item in the archive that has the given path.
          *
+         * @note The first lookup builds an index of the paths of all the archive's items,
+         *       so that the following lookups take constant time.
+         *       Path separators are normalized (e.g., on Windows, both '/' and '\\' are accepted),
+         *       and if more items have the same path, the first one is returned.
+         *
          * @param path the path to be searched in the archive.
          *
          * @return an iterator to the item with the given path, or an iterator equal to the end() iterator
@@ -114,7 +114,7 @@ class BitItemsVector final {
          * @param inBuffer  the buffer containing the file to be indexed in the vector.
          * @param name      user-defined path to be used inside archives.
          */
-        void indexBuffer( const std::vector< byte_t >& inBuffer, const tstring& name );
+        void indexBuffer( BufferView inBuffer, const tstring& name );
 
         /**
          * @brief Indexes the given standard input stream, using the given name as a path when compressed in archives.
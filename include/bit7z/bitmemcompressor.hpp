@@ -20,8 +20,10 @@ namespace bit7z {
  *
  * It let decide various properties of the produced archive, such as the password
  * protection and the compression level desired.
+ *
+ * @note The input buffers are passed as a BufferView, so any contiguous memory region can be compressed in place.
  */
-using BitMemCompressor BIT7Z_MAYBE_UNUSED = BitCompressor< const std::vector< byte_t >& >;
+using BitMemCompressor BIT7Z_MAYBE_UNUSED = BitCompressor< BufferView >;
 
 } // namespace bit7z
 #endif // BITMEMCOMPRESSOR_HPP
@@ -16,8 +16,11 @@ namespace bit7z {
 
 /**
  * @brief The BitMemExtractor alias allows extracting the content of in-memory archives.
+ *
+ * @note In-memory archives are passed as a BufferView, so they can be read in place from any contiguous memory
+ * region (e.g., a `std::vector< byte_t >`, which is implicitly convertible to BufferView) without copying them.
  */
-using BitMemExtractor BIT7Z_MAYBE_UNUSED = BitExtractor< const std::vector< byte_t >& >;
+using BitMemExtractor BIT7Z_MAYBE_UNUSED = BitExtractor< BufferView >;
 
 } // namespace bit7z
 
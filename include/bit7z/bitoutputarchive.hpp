@@ -91,7 +91,7 @@ class BitOutputArchive {
          *                  be used for creating the new archive and reading the (optional) input archive.
          * @param inBuffer  the buffer containing an input archive file.
          */
-        BitOutputArchive( const BitAbstractArchiveCreator& creator, const std::vector< byte_t >& inBuffer );
+        BitOutputArchive( const BitAbstractArchiveCreator& creator, BufferView inBuffer );
 
         /**
          * @brief Constructs a BitOutputArchive object, reading an input file archive from the given std::istream.
@@ -142,7 +142,7 @@ class BitOutputArchive {
          * @param inBuffer  the buffer containing the file to be added to the output archive.
          * @param name      user-defined path to be used inside the output archive.
          */
-        void addFile( const std::vector< byte_t >& inBuffer, const tstring& name );
+        void addFile( BufferView inBuffer, const tstring& name );
 
         /**
          * @brief Adds the given standard input stream, using the given name as a path when compressed
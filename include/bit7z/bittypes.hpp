@@ -10,6 +10,7 @@
 #ifndef BITTYPES_HPP
 #define BITTYPES_HPP
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -60,6 +61,77 @@ struct StringTraits< wchar_t > {
 };
 /** @endcond */
 
+/**
+ * @brief A non-owning, read-only view over a contiguous sequence of bytes (similar to a `std::span< const byte_t >`).
+ *
+ * It allows reading archives (and compressing data) directly from memory that is not owned by a `std::vector`,
+ * e.g., memory-mapped regions, shared memory segments, or pooled network buffers, without copying it.
+ *
+ * @note The viewed memory is not copied: it must remain valid for the whole lifetime of the objects using it.
+ */
+class BufferView final {
+    public:
+        /**
+         * @brief Constructs an empty BufferView.
+         */
+        constexpr BufferView() noexcept = default;
+
+        /**
+         * @brief Constructs a BufferView over the given memory region.
+         *
+         * @param data  the pointer to the first byte of the region.
+         * @param size  the size (in bytes) of the region.
+         */
+        constexpr BufferView( const byte_t* data, std::size_t size ) noexcept : mData{ data }, mSize{ size } {}
+
+        /**
+         * @brief Constructs a BufferView over the content of the given buffer.
+         *
+         * @param buffer  the buffer to be viewed.
+         */
+        BufferView( const buffer_t& buffer ) noexcept // NOLINT(google-explicit-constructor)
+            : mData{ buffer.data() }, mSize{ buffer.size() } {}
+
+        /**
+         * @return the pointer to the first byte of the viewed memory.
+         */
+        BIT7Z_NODISCARD constexpr auto data() const noexcept -> const byte_t* {
+            return mData;
+        }
+
+        /**
+         * @return the size (in bytes) of the viewed memory.
+         */
+        BIT7Z_NODISCARD constexpr auto size() const noexcept -> std::size_t {
+            return mSize;
+        }
+
+        /**
+         * @return true if the view doesn't contain any byte, false otherwise.
+         */
+        BIT7Z_NODISCARD constexpr auto empty() const noexcept -> bool {
+            return mSize == 0;
+        }
+
+        /**
+         * @return the pointer to the first byte of the viewed memory.
+         */
+        BIT7Z_NODISCARD constexpr auto begin() const noexcept -> const byte_t* {
+            return mData;
+        }
+
+        /**
+         * @return the pointer past the last byte of the viewed memory.
+         */
+        BIT7Z_NODISCARD constexpr auto end() const noexcept -> const byte_t* {
+            return mData + mSize;
+        }
+
+    private:
+        const byte_t* mData{ nullptr };
+        std::size_t mSize{ 0 };
+};
+
 /**
  * Native string type of the system.
  * @note On Windows, it is an alias of `std::wstring`.
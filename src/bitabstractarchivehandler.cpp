@@ -20,7 +20,10 @@ BitAbstractArchiveHandler::BitAbstractArchiveHandler( const Bit7zLibrary& lib,
     : mLibrary{ lib },
       mPassword{ std::move( password ) },
       mRetainDirectories{ true },
-      mOverwriteMode{ overwriteMode } {}
+      mOverwriteMode{ overwriteMode },
+      mFileAccessMode{ FileAccessMode::Stream },
+      mAccessPatternHint{ AccessPatternHint::Normal },
+      mExtractionOptions{} {}
 
 auto BitAbstractArchiveHandler::library() const noexcept -> const Bit7zLibrary& {
     return mLibrary;
@@ -62,6 +65,18 @@ auto BitAbstractArchiveHandler::overwriteMode() const -> OverwriteMode {
     return mOverwriteMode;
 }
 
+auto BitAbstractArchiveHandler::fileAccessMode() const noexcept -> FileAccessMode {
+    return mFileAccessMode;
+}
+
+auto BitAbstractArchiveHandler::accessPatternHint() const noexcept -> AccessPatternHint {
+    return mAccessPatternHint;
+}
+
+auto BitAbstractArchiveHandler::extractionOptions() const noexcept -> const ExtractionOptions& {
+    return mExtractionOptions;
+}
+
 void BitAbstractArchiveHandler::setPassword( const tstring& password ) {
     mPassword = password;
 }
@@ -97,3 +112,15 @@ void BitAbstractArchiveHandler::setPasswordCallback( const PasswordCallback& cal
 void BitAbstractArchiveHandler::setOverwriteMode( OverwriteMode mode ) {
     mOverwriteMode = mode;
 }
+
+void BitAbstractArchiveHandler::setFileAccessMode( FileAccessMode mode ) noexcept {
+    mFileAccessMode = mode;
+}
+
+void BitAbstractArchiveHandler::setAccessPatternHint( AccessPatternHint hint ) noexcept {
+    mAccessPatternHint = hint;
+}
+
+void BitAbstractArchiveHandler::setExtractionOptions( const ExtractionOptions& options ) noexcept {
+    mExtractionOptions = options;
+}
@@ -17,7 +17,8 @@ using namespace bit7z;
 BitAbstractArchiveOpener::BitAbstractArchiveOpener( const Bit7zLibrary& lib,
                                                     const BitInFormat& format,
                                                     const tstring& password )
-    : BitAbstractArchiveHandler{ lib, password, OverwriteMode::Overwrite }, mFormat{ format } {}
+    : BitAbstractArchiveHandler{ lib, password, OverwriteMode::Overwrite },
+      mFormat{ format } {}
 
 auto BitAbstractArchiveOpener::format() const noexcept -> const BitInFormat& {
     return mFormat;
@@ -26,3 +27,53 @@ auto BitAbstractArchiveOpener::format() const noexcept -> const BitInFormat& {
 auto BitAbstractArchiveOpener::extractionFormat() const noexcept -> const BitInFormat& {
     return mFormat;
 }
+
+auto BitAbstractArchiveOpener::readAheadWindowSize() const noexcept -> std::size_t {
+    return extractionOptions().readAheadWindowSize;
+}
+
+void BitAbstractArchiveOpener::setReadAheadWindowSize( std::size_t windowSize ) noexcept {
+    ExtractionOptions options = extractionOptions();
+    options.readAheadWindowSize = windowSize;
+    setExtractionOptions( options );
+}
+
+auto BitAbstractArchiveOpener::unbufferedExtraction() const noexcept -> bool {
+    return extractionOptions().unbuffered;
+}
+
+void BitAbstractArchiveOpener::setUnbufferedExtraction( bool unbuffered ) noexcept {
+    ExtractionOptions options = extractionOptions();
+    options.unbuffered = unbuffered;
+    setExtractionOptions( options );
+}
+
+auto BitAbstractArchiveOpener::preallocateExtractedFiles() const noexcept -> bool {
+    return extractionOptions().preallocateFiles;
+}
+
+void BitAbstractArchiveOpener::setPreallocateExtractedFiles( bool preallocate ) noexcept {
+    ExtractionOptions options = extractionOptions();
+    options.preallocateFiles = preallocate;
+    setExtractionOptions( options );
+}
+
+auto BitAbstractArchiveOpener::extractionThreads() const noexcept -> std::size_t {
+    return extractionOptions().threads;
+}
+
+void BitAbstractArchiveOpener::setExtractionThreads( std::size_t threadsCount ) noexcept {
+    ExtractionOptions options = extractionOptions();
+    options.threads = threadsCount;
+    setExtractionOptions( options );
+}
+
+auto BitAbstractArchiveOpener::extractionWriterThreads() const noexcept -> std::size_t {
+    return extractionOptions().writerThreads;
+}
+
+void BitAbstractArchiveOpener::setExtractionWriterThreads( std::size_t threadsCount ) noexcept {
+    ExtractionOptions options = extractionOptions();
+    options.writerThreads = threadsCount;
+    setExtractionOptions( options );
+}
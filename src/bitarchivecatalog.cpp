@@ -0,0 +1,269 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+
+#include "bitarchivecatalog.hpp"
+#include "biterror.hpp"
+#include "bitexception.hpp"
+#include "bitinputarchive.hpp"
+#include "internal/dateutil.hpp"
+
+namespace bit7z {
+
+namespace {
+
+constexpr uint32_t kNoDirectory = static_cast< uint32_t >( -1 );
+
+// The pooled strings are referenced by 32-bit offsets and sizes.
+constexpr std::size_t kMaxPoolSize = std::numeric_limits< uint32_t >::max();
+
+#ifdef _WIN32
+constexpr auto kPathSeparators = BIT7Z_STRING( "\\/" );
+constexpr auto kPathSeparator = BIT7Z_STRING( '\\' );
+#else
+constexpr auto kPathSeparators = BIT7Z_STRING( "/" );
+constexpr auto kPathSeparator = BIT7Z_STRING( '/' );
+#endif
+
+enum ItemFlag : uint8_t {
+    IsDir = 1U << 0U,
+    IsEncrypted = 1U << 1U,
+    HasCreationTime = 1U << 2U,
+    HasAccessTime = 1U << 3U,
+    HasWriteTime = 1U << 4U
+};
+
+inline auto filetime_to_uint64( FILETIME fileTime ) noexcept -> uint64_t {
+    return ( static_cast< uint64_t >( fileTime.dwHighDateTime ) << 32U ) | fileTime.dwLowDateTime;
+}
+
+inline auto uint64_to_filetime( uint64_t value ) noexcept -> FILETIME {
+    FILETIME fileTime{};
+    fileTime.dwHighDateTime = static_cast< DWORD >( value >> 32U );
+    fileTime.dwLowDateTime = static_cast< DWORD >( value & 0xFFFFFFFFU );
+    return fileTime;
+}
+
+} // namespace
+
+BitArchiveCatalog::BitArchiveCatalog( const BitInputArchive& archive ) {
+    const uint32_t count = archive.itemsCount();
+    mParents.reserve( count );
+    mNames.reserve( count );
+    mSizes.reserve( count );
+    mPackSizes.reserve( count );
+    mCrcs.reserve( count );
+    mAttributes.reserve( count );
+    mCreationTimes.reserve( count );
+    mAccessTimes.reserve( count );
+    mWriteTimes.reserve( count );
+    mFlags.reserve( count );
+
+    // Maps each directory prefix to its entry in mDirectories; it's needed only while building the catalog.
+    std::unordered_map< tstring, uint32_t > directoriesIds;
+    const auto internDirectory = [ this, &directoriesIds ]( const tstring& itemPath, std::size_t prefixSize ) {
+        // Finding the longest prefix of the directory that has already been interned.
+        uint32_t parent = kNoDirectory;
+        std::size_t componentStart = 0;
+        std::size_t knownSize = prefixSize;
+        while ( true ) {
+            const auto found = directoriesIds.find( itemPath.substr( 0, knownSize ) );
+            if ( found != directoriesIds.end() ) {
+                parent = found->second;
+                componentStart = knownSize + 1;
+                break;
+            }
+            const auto separator = knownSize == 0 ? tstring::npos : itemPath.find_last_of( kPathSeparators,
+                                                                                           knownSize - 1 );
+            if ( separator == tstring::npos ) {
+                break;
+            }
+            knownSize = separator;
+        }
+
+        // Interning the remaining path components, each one as a child of the previous one.
+        while ( componentStart <= prefixSize ) {
+            auto componentEnd = itemPath.find_first_of( kPathSeparators, componentStart );
+            if ( componentEnd == tstring::npos || componentEnd > prefixSize ) {
+                componentEnd = prefixSize;
+            }
+            const auto name = internString( itemPath.data() + componentStart, componentEnd - componentStart );
+            mDirectories.push_back( { parent, name } );
+            parent = static_cast< uint32_t >( mDirectories.size() - 1 );
+            directoriesIds.emplace( itemPath.substr( 0, componentEnd ), parent );
+            componentStart = componentEnd + 1;
+        }
+        return parent;
+    };
+
+    for ( uint32_t index = 0; index < count; ++index ) {
+        BitPropVariant itemPath = archive.itemProperty( index, BitProperty::Path );
+        if ( itemPath.isEmpty() ) {
+            itemPath = archive.itemProperty( index, BitProperty::Name );
+        }
+        const tstring fullPath = itemPath.isEmpty() ? tstring{} : itemPath.getString();
+
+        const auto separator = fullPath.find_last_of( kPathSeparators );
+        if ( separator == tstring::npos ) {
+            mParents.push_back( kNoDirectory );
+            mNames.push_back( internString( fullPath.data(), fullPath.size() ) );
+        } else {
+            mParents.push_back( internDirectory( fullPath, separator ) );
+            mNames.push_back( internString( fullPath.data() + separator + 1, fullPath.size() - separator - 1 ) );
+        }
+
+        uint8_t flags = 0;
+        const BitPropVariant isDir = archive.itemProperty( index, BitProperty::IsDir );
+        if ( isDir.isBool() && isDir.getBool() ) {
+            flags |= ItemFlag::IsDir;
+        }
+        const BitPropVariant isEncrypted = archive.itemProperty( index, BitProperty::Encrypted );
+        if ( isEncrypted.isBool() && isEncrypted.getBool() ) {
+            flags |= ItemFlag::IsEncrypted;
+        }
+
+        const BitPropVariant size = archive.itemProperty( index, BitProperty::Size );
+        mSizes.push_back( size.isEmpty() ? 0 : size.getUInt64() );
+        const BitPropVariant packSize = archive.itemProperty( index, BitProperty::PackSize );
+        mPackSizes.push_back( packSize.isEmpty() ? 0 : packSize.getUInt64() );
+        const BitPropVariant crc = archive.itemProperty( index, BitProperty::CRC );
+        mCrcs.push_back( crc.isUInt32() ? crc.getUInt32() : 0 );
+        const BitPropVariant attributes = archive.itemProperty( index, BitProperty::Attrib );
+        mAttributes.push_back( attributes.isUInt32() ? attributes.getUInt32() : 0 );
+
+        const auto pushTime = [ &archive, index, &flags ]( std::vector< uint64_t >& column,
+                                                          BitProperty property,
+                                                          uint8_t flag ) {
+            const BitPropVariant time = archive.itemProperty( index, property );
+            if ( time.isFileTime() ) {
+                column.push_back( filetime_to_uint64( time.getFileTime() ) );
+                flags |= flag;
+            } else {
+                column.push_back( 0 );
+            }
+        };
+        pushTime( mCreationTimes, BitProperty::CTime, ItemFlag::HasCreationTime );
+        pushTime( mAccessTimes, BitProperty::ATime, ItemFlag::HasAccessTime );
+        pushTime( mWriteTimes, BitProperty::MTime, ItemFlag::HasWriteTime );
+        mFlags.push_back( flags );
+    }
+    mStringPool.shrink_to_fit();
+    mDirectories.shrink_to_fit();
+}
+
+auto BitArchiveCatalog::internString( const tchar* str, std::size_t size ) -> StringRef {
+    if ( size > kMaxPoolSize - mStringPool.size() ) {
+        throw BitException( "Cannot catalog the archive items", std::make_error_code( std::errc::value_too_large ) );
+    }
+    const StringRef ref{ static_cast< uint32_t >( mStringPool.size() ), static_cast< uint32_t >( size ) };
+    mStringPool.append( str, size );
+    return ref;
+}
+
+void BitArchiveCatalog::checkIndex( uint32_t index ) const {
+    if ( index >= itemsCount() ) {
+        throw BitException( "Cannot get the item at the index " + std::to_string( index ),
+                            make_error_code( BitError::InvalidIndex ) );
+    }
+}
+
+auto BitArchiveCatalog::pooledString( StringRef ref ) const -> tstring {
+    return mStringPool.substr( ref.offset, ref.size );
+}
+
+auto BitArchiveCatalog::itemsCount() const noexcept -> uint32_t {
+    return static_cast< uint32_t >( mFlags.size() );
+}
+
+auto BitArchiveCatalog::path( uint32_t index ) const -> tstring {
+    checkIndex( index );
+    const StringRef itemName = mNames[ index ];
+
+    std::vector< const Directory* > ancestors;
+    std::size_t pathSize = itemName.size;
+    for ( uint32_t parent = mParents[ index ]; parent != kNoDirectory; parent = mDirectories[ parent ].parent ) {
+        ancestors.push_back( &mDirectories[ parent ] );
+        pathSize += mDirectories[ parent ].name.size + 1;
+    }
+
+    tstring result;
+    result.reserve( pathSize );
+    for ( auto ancestor = ancestors.crbegin(); ancestor != ancestors.crend(); ++ancestor ) {
+        result.append( mStringPool, ( *ancestor )->name.offset, ( *ancestor )->name.size );
+        result.push_back( kPathSeparator );
+    }
+    result.append( mStringPool, itemName.offset, itemName.size );
+    return result;
+}
+
+auto BitArchiveCatalog::name( uint32_t index ) const -> tstring {
+    checkIndex( index );
+    return pooledString( mNames[ index ] );
+}
+
+auto BitArchiveCatalog::isDir( uint32_t index ) const -> bool {
+    checkIndex( index );
+    return ( mFlags[ index ] & ItemFlag::IsDir ) != 0;
+}
+
+auto BitArchiveCatalog::isEncrypted( uint32_t index ) const -> bool {
+    checkIndex( index );
+    return ( mFlags[ index ] & ItemFlag::IsEncrypted ) != 0;
+}
+
+auto BitArchiveCatalog::size( uint32_t index ) const -> uint64_t {
+    checkIndex( index );
+    return mSizes[ index ];
+}
+
+auto BitArchiveCatalog::packSize( uint32_t index ) const -> uint64_t {
+    checkIndex( index );
+    return mPackSizes[ index ];
+}
+
+auto BitArchiveCatalog::crc( uint32_t index ) const -> uint32_t {
+    checkIndex( index );
+    return mCrcs[ index ];
+}
+
+auto BitArchiveCatalog::attributes( uint32_t index ) const -> uint32_t {
+    checkIndex( index );
+    return mAttributes[ index ];
+}
+
+auto BitArchiveCatalog::itemTime( const std::vector< uint64_t >& column, uint32_t index, uint8_t flag ) const
+    -> time_type {
+    checkIndex( index );
+    if ( ( mFlags[ index ] & flag ) == 0 ) {
+        return time_type::clock::now();
+    }
+    return FILETIME_to_time_type( uint64_to_filetime( column[ index ] ) );
+}
+
+auto BitArchiveCatalog::creationTime( uint32_t index ) const -> time_type {
+    return itemTime( mCreationTimes, index, ItemFlag::HasCreationTime );
+}
+
+auto BitArchiveCatalog::lastAccessTime( uint32_t index ) const -> time_type {
+    return itemTime( mAccessTimes, index, ItemFlag::HasAccessTime );
+}
+
+auto BitArchiveCatalog::lastWriteTime( uint32_t index ) const -> time_type {
+    return itemTime( mWriteTimes, index, ItemFlag::HasWriteTime );
+}
+
+} // namespace bit7z
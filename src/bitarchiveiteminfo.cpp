@@ -17,17 +17,40 @@ using bit7z::BitProperty;
 using bit7z::BitPropVariant;
 using std::map;
 
-BitArchiveItemInfo::BitArchiveItemInfo( uint32_t itemIndex ) : BitArchiveItem( itemIndex ) {}
+BitArchiveItemInfo::BitArchiveItemInfo( uint32_t itemIndex )
+    : BitArchiveItem( itemIndex ), mSlots{} {}
 
 auto BitArchiveItemInfo::itemProperty( BitProperty property ) const -> BitPropVariant {
-    const auto propIt = mItemProperties.find( property );
-    return ( propIt != mItemProperties.end() ? ( *propIt ).second : BitPropVariant() );
+    const auto slot = static_cast< std::size_t >( property );
+    if ( slot >= kPropertiesCount || !mAvailableProperties.test( slot ) ) {
+        return BitPropVariant();
+    }
+    return mValues[ mSlots[ slot ] ];
 }
 
 auto BitArchiveItemInfo::itemProperties() const -> map< BitProperty, BitPropVariant > {
-    return mItemProperties;
+    map< BitProperty, BitPropVariant > result;
+    for ( std::size_t slot = 0; slot < kPropertiesCount; ++slot ) {
+        if ( mAvailableProperties.test( slot ) ) {
+            const auto property = static_cast< BitProperty >( slot );
+            result.emplace( property, itemProperty( property ) );
+        }
+    }
+    return result;
 }
 
 void BitArchiveItemInfo::setProperty( BitProperty property, const BitPropVariant& value ) {
-    mItemProperties[ property ] = value;
+    const auto slot = static_cast< std::size_t >( property );
+    if ( slot >= kPropertiesCount ) {
+        return;
+    }
+
+    // Note: if the property was already set, its slot is reused.
+    if ( mAvailableProperties.test( slot ) ) {
+        mValues[ mSlots[ slot ] ] = value;
+    } else {
+        mSlots[ slot ] = static_cast< uint8_t >( mValues.size() );
+        mValues.push_back( value );
+        mAvailableProperties.set( slot );
+    }
 }
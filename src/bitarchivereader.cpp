@@ -10,8 +10,7 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 
-#include <algorithm>
-#include <numeric>
+#include <mutex>
 
 #include "bitarchivereader.hpp"
 #include "internal/operationresult.hpp"
@@ -22,19 +21,25 @@ BitArchiveReader::BitArchiveReader( const Bit7zLibrary& lib,
                                     const tstring& inArchive,
                                     const BitInFormat& format,
                                     const tstring& password )
-    : BitAbstractArchiveOpener( lib, format, password ), BitInputArchive( *this, inArchive ) {}
+    : BitAbstractArchiveOpener( lib, format, password ), BitInputArchive( *this, inArchive ),
+      mSummary{},
+      mSummaryValid{ false } {}
 
 BitArchiveReader::BitArchiveReader( const Bit7zLibrary& lib,
-                                    const std::vector< byte_t >& inArchive,
+                                    BufferView inArchive,
                                     const BitInFormat& format,
                                     const tstring& password )
-    : BitAbstractArchiveOpener( lib, format, password ), BitInputArchive( *this, inArchive ) {}
+    : BitAbstractArchiveOpener( lib, format, password ), BitInputArchive( *this, inArchive ),
+      mSummary{},
+      mSummaryValid{ false } {}
 
 BitArchiveReader::BitArchiveReader( const Bit7zLibrary& lib,
                                     std::istream& inArchive,
                                     const BitInFormat& format,
                                     const tstring& password )
-    : BitAbstractArchiveOpener( lib, format, password ), BitInputArchive( *this, inArchive ) {}
+    : BitAbstractArchiveOpener( lib, format, password ), BitInputArchive( *this, inArchive ),
+      mSummary{},
+      mSummaryValid{ false } {}
 
 auto BitArchiveReader::archiveProperties() const -> map< BitProperty, BitPropVariant > {
     map< BitProperty, BitPropVariant > result;
@@ -69,43 +74,76 @@ auto BitArchiveReader::items() const -> std::vector< BitArchiveItemInfo > {
     return result;
 }
 
+auto BitArchiveReader::itemsProperties( const vector< BitProperty >& properties ) const
+    -> vector< BitPropertyColumn > {
+    const auto count = itemsCount();
+
+    vector< BitPropertyColumn > result( properties.size() );
+    for ( auto& column : result ) {
+        column.reserve( count );
+    }
+    for ( uint32_t i = 0; i < count; ++i ) {
+        for ( std::size_t column = 0; column < properties.size(); ++column ) {
+            result[ column ].push_back( itemProperty( i, properties[ column ] ) );
+        }
+    }
+    return result;
+}
+
+auto BitArchiveReader::summary() const -> BitArchiveSummary {
+    const std::lock_guard< std::mutex > lock{ mSummaryMutex };
+    if ( !mSummaryValid ) {
+        BitArchiveSummary summary{};
+        uint32_t encryptedFilesCount = 0;
+        for ( const auto& item : *this ) {
+            if ( item.isDir() ) {
+                ++summary.foldersCount;
+                continue;
+            }
+            ++summary.filesCount;
+            summary.size += item.size();
+            summary.packSize += item.packSize();
+            /* Note: simple encryption (i.e., not including the archive headers) can be detected only reading
+             *       the properties of the files in the archive, so we count the encrypted files inside the archive. */
+            if ( item.isEncrypted() ) {
+                ++encryptedFilesCount;
+            }
+        }
+        summary.hasEncryptedItems = encryptedFilesCount > 0;
+        summary.isEncrypted = summary.filesCount > 0 && encryptedFilesCount == summary.filesCount;
+        mSummary = summary;
+        mSummaryValid = true;
+    }
+    return mSummary;
+}
+
+void BitArchiveReader::invalidateSummary() noexcept {
+    const std::lock_guard< std::mutex > lock{ mSummaryMutex };
+    mSummaryValid = false;
+}
+
 auto BitArchiveReader::foldersCount() const -> uint32_t {
-    return std::count_if( cbegin(), cend(), []( const BitArchiveItem& item ) {
-        return item.isDir();
-    } );
+    return summary().foldersCount;
 }
 
 auto BitArchiveReader::filesCount() const -> uint32_t {
-    return itemsCount() - foldersCount(); // I'm lazy :)
+    return summary().filesCount;
 }
 
 auto BitArchiveReader::size() const -> uint64_t {
-    return std::accumulate( cbegin(), cend(), 0ull, []( uint64_t accumulator, const BitArchiveItem& item ) {
-        return item.isDir() ? accumulator : accumulator + item.size();
-    } );
+    return summary().size;
 }
 
 auto BitArchiveReader::packSize() const -> uint64_t {
-    return std::accumulate( cbegin(), cend(), 0ull, []( uint64_t accumulator, const BitArchiveItem& item ) {
-        return item.isDir() ? accumulator : accumulator + item.packSize();
-    } );
+    return summary().packSize;
 }
 
 auto BitArchiveReader::hasEncryptedItems() const -> bool {
-    /* Note: simple encryption (i.e., not including the archive headers) can be detected only reading
-     *       the properties of the files in the archive, so we search for any encrypted file inside the archive. */
-    return std::any_of( cbegin(), cend(), []( const BitArchiveItem& item ) {
-        return !item.isDir() && item.isEncrypted();
-    } );
+    return summary().hasEncryptedItems;
 }
 
 auto BitArchiveReader::isEncrypted() const -> bool {
-    if ( filesCount() == 0 ) {
-        return false;
-    }
-    return std::all_of( cbegin(), cend(), []( const BitArchiveItem& item ) {
-        return item.isDir() || item.isEncrypted();
-    } );
+    return summary().isEncrypted;
 }
 
 auto BitArchiveReader::isMultiVolume() const -> bool {
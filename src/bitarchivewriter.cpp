@@ -26,7 +26,7 @@ BitArchiveWriter::BitArchiveWriter( const Bit7zLibrary& lib,
       BitOutputArchive( *this, inArchive ) {}
 
 BitArchiveWriter::BitArchiveWriter( const Bit7zLibrary& lib,
-                                    const std::vector< byte_t >& inArchive,
+                                    BufferView inArchive,
                                     const BitInOutFormat& format,
                                     const tstring& password )
     : BitAbstractArchiveCreator( lib, format, password, UpdateMode::Append ),
@@ -0,0 +1,77 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <algorithm>
+
+#include "bitextracteddata.hpp"
+
+namespace bit7z {
+
+auto BitExtractedData::size() const noexcept -> std::size_t {
+    return mEntries.size();
+}
+
+auto BitExtractedData::empty() const noexcept -> bool {
+    return mEntries.empty();
+}
+
+auto BitExtractedData::comparePath( const Entry& entry, const tstring& path ) const noexcept -> int {
+    return mPaths.compare( entry.pathOffset, entry.pathSize, path );
+}
+
+auto BitExtractedData::comparePaths( const Entry& first, const Entry& second ) const noexcept -> int {
+    return mPaths.compare( first.pathOffset, first.pathSize, mPaths, second.pathOffset, second.pathSize );
+}
+
+auto BitExtractedData::find( const tstring& path ) const -> std::size_t {
+    const auto found = std::lower_bound( mEntries.cbegin(), mEntries.cend(), path,
+                                         [ this ]( const Entry& entry, const tstring& value ) -> bool {
+                                             return comparePath( entry, value ) < 0;
+                                         } );
+    if ( found == mEntries.cend() || comparePath( *found, path ) != 0 ) {
+        return mEntries.size();
+    }
+    return static_cast< std::size_t >( found - mEntries.cbegin() );
+}
+
+auto BitExtractedData::contains( const tstring& path ) const -> bool {
+    return find( path ) != mEntries.size();
+}
+
+auto BitExtractedData::path( std::size_t position ) const -> tstring {
+    const auto& entry = mEntries.at( position );
+    return mPaths.substr( entry.pathOffset, entry.pathSize );
+}
+
+auto BitExtractedData::index( std::size_t position ) const -> uint32_t {
+    return mEntries.at( position ).index;
+}
+
+auto BitExtractedData::data( std::size_t position ) const -> const byte_t* {
+    return mArena.data() + mEntries.at( position ).dataOffset; //-V2563
+}
+
+auto BitExtractedData::dataSize( std::size_t position ) const -> std::size_t {
+    return mEntries.at( position ).dataSize;
+}
+
+auto BitExtractedData::arena() const noexcept -> const std::vector< byte_t >& {
+    return mArena;
+}
+
+void BitExtractedData::clear() noexcept {
+    std::vector< byte_t >{}.swap( mArena );
+    tstring{}.swap( mPaths );
+    std::vector< Entry >{}.swap( mEntries );
+}
+
+} // namespace bit7z
@@ -18,14 +18,21 @@
 
 #include "biterror.hpp"
 #include "bitexception.hpp"
+#include "internal/asyncwriterpool.hpp"
 #include "internal/bufferextractcallback.hpp"
 #include "internal/cbufferinstream.hpp"
-#include "internal/cfileinstream.hpp"
+#include "internal/cmappedfileinstream.hpp"
 #include "internal/cmultivolumeinstream.hpp"
+#include "internal/creadaheadinstream.hpp"
+#include "internal/cstdinstream.hpp"
 #include "internal/fileextractcallback.hpp"
+#include "internal/filestreams.hpp"
 #include "internal/fixedbufferextractcallback.hpp"
+#include "internal/fsutil.hpp"
+#include "internal/sinkextractcallback.hpp"
 #include "internal/streamextractcallback.hpp"
 #include "internal/opencallback.hpp"
+#include "internal/parallelextractcontext.hpp"
 #include "internal/stringutil.hpp"
 #include "internal/util.hpp"
 
@@ -34,6 +41,10 @@
 #endif
 
 #include <algorithm>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <utility>
 
 using namespace NWindows;
 using namespace NArchive;
@@ -122,29 +133,56 @@ inline auto detect_format( const BitInFormat& format, const fs::path& arcPath )
 BitInputArchive::BitInputArchive( const BitAbstractArchiveHandler& handler, const tstring& inFile )
     : BitInputArchive( handler, tstring_to_path( inFile ) ) {}
 
+/* Maps the archive file in memory; if it is not possible (e.g., for pipes and other special files,
+ * or for files larger than the address space), it returns a null stream, so that the file is read normally. */
+inline auto map_archive_file( const fs::path& arcPath, AccessPatternHint hint ) -> CMyComPtr< IInStream > {
+    try {
+        return bit7z::make_com< CMappedFileInStream, IInStream >( arcPath, hint );
+    } catch ( const BitException& ) {
+        return nullptr;
+    }
+}
+
 BitInputArchive::BitInputArchive( const BitAbstractArchiveHandler& handler, const fs::path& arcPath )
     : mDetectedFormat{ detect_format( handler.format(), arcPath ) },
       mArchiveHandler{ handler },
-      mArchivePath{ path_to_tstring( arcPath ) } {
+      mArchivePath{ path_to_tstring( arcPath ) },
+      mPathIndexBuilt{ false } {
     CMyComPtr< IInStream > fileStream;
+    const std::size_t readAheadWindowSize = handler.extractionOptions().readAheadWindowSize;
+    bool useReadAhead = readAheadWindowSize > 0;
     if ( *mDetectedFormat != BitFormat::Split && arcPath.extension() == ".001" ) {
         fileStream = bit7z::make_com< CMultiVolumeInStream, IInStream >( arcPath );
-    } else {
-        fileStream = bit7z::make_com< CFileInStream, IInStream >( arcPath );
+    } else if ( handler.fileAccessMode() == FileAccessMode::MemoryMapped ) {
+        fileStream = map_archive_file( arcPath, handler.accessPatternHint() );
+        // Memory-mapped files are already read ahead by the OS paging mechanism.
+        useReadAhead = useReadAhead && fileStream == nullptr;
+    }
+    if ( fileStream == nullptr ) { // Note: the file is read through a stream also when it couldn't be mapped.
+        fileStream = bit7z::make_com< FileInStream, IInStream >( arcPath );
+    }
+    if ( useReadAhead ) {
+        fileStream = bit7z::make_com< CReadAheadInStream, IInStream >( fileStream, readAheadWindowSize );
     }
     mInArchive = openArchiveStream( arcPath, fileStream );
 }
 
-BitInputArchive::BitInputArchive( const BitAbstractArchiveHandler& handler, const std::vector< byte_t >& inBuffer )
+BitInputArchive::BitInputArchive( const BitAbstractArchiveHandler& handler, BufferView inBuffer )
     : mDetectedFormat{ &handler.format() }, // if auto, detect the format from content, otherwise try the passed format.
-      mArchiveHandler{ handler } {
+      mArchiveHandler{ handler },
+      mArchiveBuffer{ inBuffer },
+      mPathIndexBuilt{ false } {
     auto bufStream = bit7z::make_com< CBufferInStream, IInStream >( inBuffer );
     mInArchive = openArchiveStream( fs::path{}, bufStream );
 }
 
+BitInputArchive::BitInputArchive( const BitAbstractArchiveHandler& handler, const byte_t* inData, std::size_t size )
+    : BitInputArchive( handler, BufferView{ inData, size } ) {}
+
 BitInputArchive::BitInputArchive( const BitAbstractArchiveHandler& handler, std::istream& inStream )
     : mDetectedFormat{ &handler.format() }, // if auto, detect the format from content, otherwise try the passed format.
-      mArchiveHandler{ handler } {
+      mArchiveHandler{ handler },
+      mPathIndexBuilt{ false } {
     auto stdStream = bit7z::make_com< CStdInStream, IInStream >( inStream );
     mInArchive = openArchiveStream( fs::path{}, stdStream );
 }
@@ -179,6 +217,31 @@ auto BitInputArchive::itemProperty( uint32_t index, BitProperty property ) const
     return itemProperty;
 }
 
+auto BitInputArchive::availableItemProperties() const -> std::vector< BitProperty > {
+    UInt32 numProperties = 0;
+    HRESULT res = mInArchive->GetNumberOfProperties( &numProperties );
+    if ( res != S_OK ) {
+        throw BitException( "Could not retrieve the number of item properties", make_hresult_code( res ) );
+    }
+
+    std::vector< BitProperty > result;
+    result.reserve( numProperties );
+    for ( UInt32 i = 0; i < numProperties; ++i ) {
+        BSTR name = nullptr;
+        PROPID propertyId = kpidNoProperty;
+        VARTYPE type = VT_EMPTY;
+        res = mInArchive->GetPropertyInfo( i, &name, &propertyId, &type );
+        if ( name != nullptr ) {
+            ::SysFreeString( name );
+        }
+        if ( res != S_OK ) {
+            throw BitException( "Could not retrieve the information of an item property", make_hresult_code( res ) );
+        }
+        result.push_back( static_cast< BitProperty >( propertyId ) );
+    }
+    return result;
+}
+
 auto BitInputArchive::itemsCount() const -> uint32_t {
     uint32_t itemsCount{};
     const HRESULT res = mInArchive->GetNumberOfItems( &itemsCount );
@@ -221,9 +284,175 @@ auto BitInputArchive::handler() const noexcept -> const BitAbstractArchiveHandle
     return mArchiveHandler;
 }
 
+auto BitInputArchive::parallelExtractionThreads( std::size_t itemsCount ) const -> std::size_t {
+    const std::size_t threadsCount = std::min( mArchiveHandler.extractionOptions().threads, itemsCount );
+    if ( threadsCount < 2 ) {
+        return 1;
+    }
+
+    // Each worker needs its own independent input stream, so we must be able to open the archive again.
+    if ( mArchivePath.empty() && mArchiveBuffer.data() == nullptr ) {
+        return 1;
+    }
+
+    // In solid archives, each solid block must be decoded sequentially, so we can use at most a thread per block.
+    const BitPropVariant isSolid = archiveProperty( BitProperty::Solid );
+    if ( isSolid.isBool() && isSolid.getBool() ) {
+        const BitPropVariant blocksCount = archiveProperty( BitProperty::NumBlocks );
+        if ( !blocksCount.isUInt64() || blocksCount.getUInt64() < 2 ) {
+            return 1;
+        }
+        return static_cast< std::size_t >( std::min< uint64_t >( threadsCount, blocksCount.getUInt64() ) );
+    }
+    return threadsCount;
+}
+
+/* Returns the key identifying the output file of the given item: items with the same key must be extracted
+ * by the same worker, otherwise they would race on the same file. Note: we conservatively assume the output
+ * filesystem to be case-insensitive (at worst, we just lose some parallelism). */
+inline auto output_file_key( const BitPropVariant& itemPath, bool retainDirectories ) -> std::wstring {
+    fs::path outputPath = itemPath.isString() ? fs::path{ itemPath.getNativeString() } : fs::path{};
+    if ( !retainDirectories ) {
+        outputPath = outputPath.filename();
+    }
+    return filesystem::fsutil::case_folded_path( outputPath );
+}
+
+void BitInputArchive::extractParallel( const tstring& outDir,
+                                       const std::vector< uint32_t >& indices,
+                                       std::size_t threadsCount,
+                                       AsyncWriterPool* writerPool ) const {
+    /* Items in the same solid block can only be decoded sequentially, so they must be extracted by the same worker:
+     * hence, we group the items in extraction units, i.e., the items of each block, or single items if the format
+     * doesn't expose the block of its items (e.g., zip archives), or the item is not in a block (e.g., folders).
+     * Also, items having the same output file (e.g., multiple versions of a file in a tar archive) must be
+     * extracted in order by the same worker, so their units are merged. */
+    struct ExtractionUnit {
+        uint64_t size;
+        std::vector< uint32_t > indices;
+    };
+    std::vector< ExtractionUnit > units;
+    std::vector< std::size_t > unitsParents; // Merged units point to the unit they were merged into.
+    const auto findUnit = [ &unitsParents ]( std::size_t unit ) -> std::size_t {
+        while ( unitsParents[ unit ] != unit ) {
+            unit = unitsParents[ unit ];
+        }
+        return unit;
+    };
+    std::map< uint64_t, std::size_t > blocksUnits;
+    std::map< std::wstring, std::size_t > outputFilesUnits;
+    const bool retainDirectories = mArchiveHandler.retainDirectories();
+    const auto addItem = [ & ]( uint32_t index ) {
+        const BitPropVariant itemSize = itemProperty( index, BitProperty::Size );
+        const BitPropVariant itemBlock = itemProperty( index, BitProperty::Block );
+        std::size_t unit = units.size();
+        if ( itemBlock.isUInt64() ) {
+            unit = blocksUnits.emplace( itemBlock.getUInt64(), unit ).first->second;
+        }
+        if ( unit == units.size() ) {
+            units.push_back( ExtractionUnit{ 0, {} } );
+            unitsParents.push_back( unit );
+        }
+        unit = findUnit( unit );
+
+        const auto outputFileKey = output_file_key( itemProperty( index, BitProperty::Path ), retainDirectories );
+        const std::size_t outputFileUnit = findUnit( outputFilesUnits.emplace( outputFileKey, unit ).first->second );
+        if ( outputFileUnit != unit ) {
+            auto& mergedUnit = units[ unit ];
+            auto& targetUnit = units[ outputFileUnit ];
+            targetUnit.size += mergedUnit.size;
+            targetUnit.indices.insert( targetUnit.indices.end(),
+                                       mergedUnit.indices.cbegin(),
+                                       mergedUnit.indices.cend() );
+            mergedUnit = ExtractionUnit{ 0, {} };
+            unitsParents[ unit ] = outputFileUnit;
+            unit = outputFileUnit;
+        }
+
+        // Counting also the fixed cost of creating each item.
+        units[ unit ].size += ( itemSize.isUInt64() ? itemSize.getUInt64() : 0 ) + 1;
+        units[ unit ].indices.push_back( index );
+    };
+    if ( indices.empty() ) {
+        const uint32_t numberItems = itemsCount();
+        for ( uint32_t index = 0; index < numberItems; ++index ) {
+            addItem( index );
+        }
+    } else {
+        for ( const uint32_t index : indices ) {
+            addItem( index );
+        }
+    }
+
+    // Largest units first, each one assigned to the least loaded worker.
+    std::stable_sort( units.begin(), units.end(), []( const ExtractionUnit& first,
+                                                      const ExtractionUnit& second ) -> bool {
+        return first.size > second.size;
+    } );
+    std::vector< std::vector< uint32_t > > workersIndices( threadsCount );
+    std::vector< uint64_t > workersLoads( threadsCount, 0 );
+    for ( const auto& unit : units ) {
+        if ( unit.indices.empty() ) { // The unit was merged into another one.
+            continue;
+        }
+        const auto worker = static_cast< std::size_t >(
+            std::min_element( workersLoads.cbegin(), workersLoads.cend() ) - workersLoads.cbegin() );
+        auto& workerIndices = workersIndices[ worker ];
+        workerIndices.insert( workerIndices.end(), unit.indices.cbegin(), unit.indices.cend() );
+        workersLoads[ worker ] += unit.size;
+    }
+
+    /* Each worker needs its own independent input archive (the first one uses the already opened archive).
+     * We open them here, on the calling thread, so that the open callbacks (e.g., the password callback)
+     * are never called concurrently. */
+    std::vector< std::unique_ptr< BitInputArchive > > workersArchives( threadsCount );
+    for ( std::size_t worker = 1; worker < threadsCount; ++worker ) {
+        if ( workersIndices[ worker ].empty() ) {
+            continue;
+        }
+        workersArchives[ worker ] = mArchiveBuffer.data() != nullptr ?
+                                    std::make_unique< BitInputArchive >( mArchiveHandler, mArchiveBuffer ) :
+                                    std::make_unique< BitInputArchive >( mArchiveHandler,
+                                                                         tstring_to_path( mArchivePath ) );
+    }
+
+    ParallelExtractContext context{ mArchiveHandler, threadsCount };
+    const auto extractWorker = [ & ]( std::size_t worker ) noexcept {
+        auto& workerIndices = workersIndices[ worker ];
+        if ( workerIndices.empty() || context.aborted() ) {
+            return; // Note: an empty indices vector would mean extracting all the items!
+        }
+
+        try {
+            // 7-zip expects the indices of the items to be extracted in ascending order.
+            std::sort( workerIndices.begin(), workerIndices.end() );
+            const BitInputArchive& workerArchive = worker == 0 ? *this : *workersArchives[ worker ];
+            auto callback = bit7z::make_com< FileExtractCallback >( workerArchive, outDir );
+            callback->setParallelContext( &context, worker );
+            callback->setWriterPool( writerPool );
+            extract_arc( workerArchive.mInArchive, workerIndices, callback );
+        } catch ( ... ) {
+            context.abort( std::current_exception() );
+        }
+    };
+
+    std::vector< std::future< void > > workers;
+    workers.reserve( threadsCount - 1 );
+    for ( std::size_t worker = 1; worker < threadsCount; ++worker ) {
+        workers.push_back( std::async( std::launch::async, extractWorker, worker ) );
+    }
+    extractWorker( 0 );
+    for ( auto& workerResult : workers ) {
+        workerResult.wait();
+    }
+
+    if ( context.error() ) {
+        std::rethrow_exception( context.error() );
+    }
+}
+
 void BitInputArchive::extractTo( const tstring& outDir ) const {
-    auto callback = bit7z::make_com< FileExtractCallback, ExtractCallback >( *this, outDir );
-    extract_arc( mInArchive, {}, callback );
+    extractTo( outDir, {} );
 }
 
 inline auto findInvalidIndex( const std::vector< uint32_t >& indices,
@@ -241,8 +470,32 @@ void BitInputArchive::extractTo( const tstring& outDir, const std::vector< uint3
                             make_error_code( BitError::InvalidIndex ) );
     }
 
-    auto callback = bit7z::make_com< FileExtractCallback, ExtractCallback >( *this, outDir );
-    extract_arc( mInArchive, indices, callback );
+    std::unique_ptr< AsyncWriterPool > writerPool;
+    const std::size_t writerThreads = mArchiveHandler.extractionOptions().writerThreads;
+    if ( writerThreads > 0 ) {
+        writerPool = std::make_unique< AsyncWriterPool >( writerThreads );
+    }
+
+    try {
+        const std::size_t threadsCount = parallelExtractionThreads( indices.empty() ? itemsCount() : indices.size() );
+        if ( threadsCount > 1 ) {
+            extractParallel( outDir, indices, threadsCount, writerPool.get() );
+        } else {
+            auto callback = bit7z::make_com< FileExtractCallback >( *this, outDir );
+            callback->setWriterPool( writerPool.get() );
+            extract_arc( mInArchive, indices, callback );
+        }
+    } catch ( ... ) {
+        if ( writerPool ) {
+            // If a write failed, the extraction was aborted because of it, so we rethrow the writer's error.
+            writerPool->finish();
+        }
+        throw;
+    }
+
+    if ( writerPool ) {
+        writerPool->finish(); // Waiting for the pending writes, and reporting their errors.
+    }
 }
 
 void BitInputArchive::extractTo( std::vector< byte_t >& outBuffer, uint32_t index ) const {
@@ -281,47 +534,366 @@ void BitInputArchive::extractTo( std::ostream& outStream, uint32_t index ) const
     extract_arc( mInArchive, indices, extractCallback );
 }
 
-void BitInputArchive::extractTo( byte_t* buffer, std::size_t size, uint32_t index ) const {
-    if ( buffer == nullptr ) {
-        throw BitException( "Cannot extract the item at the index " + std::to_string( index ) + " to the buffer",
-                            make_error_code( BitError::NullOutputBuffer ) );
+inline auto read_item_stream( ISequentialInStream* itemStream, byte_t* data, std::size_t size ) -> std::size_t {
+    std::size_t readSize = 0;
+    while ( readSize < size ) {
+        UInt32 processedSize = 0;
+        const auto chunkSize = clamp_cast< UInt32 >( size - readSize );
+        const HRESULT res = itemStream->Read( data + readSize, chunkSize, &processedSize ); //-V2563
+        if ( res != S_OK ) {
+            throw BitException( "Could not read the item", make_hresult_code( res ) );
+        }
+        if ( processedSize == 0 ) { // End of the item.
+            break;
+        }
+        readSize += processedSize;
+    }
+    return readSize;
+}
+
+// Size of the chunks in which the ranges are read, so that the memory used is bounded by the data actually read.
+constexpr std::size_t kRangeChunkSize = 1024 * 1024;
+
+/* Appends up to the given size of data read from the item's stream to the buffer, growing the buffer
+ * one chunk at a time; it returns the size of the data actually read. */
+inline auto append_item_stream( ISequentialInStream* itemStream,
+                                std::vector< byte_t >& buffer,
+                                std::size_t size ) -> std::size_t {
+    std::size_t readSize = 0;
+    while ( readSize < size ) {
+        const std::size_t chunkSize = std::min( size - readSize, kRangeChunkSize );
+        const std::size_t oldSize = buffer.size();
+        buffer.resize( oldSize + chunkSize );
+        const std::size_t chunkReadSize = read_item_stream( itemStream, buffer.data() + oldSize, chunkSize );
+        buffer.resize( oldSize + chunkReadSize );
+        readSize += chunkReadSize;
+        if ( chunkReadSize < chunkSize ) { // End of the item.
+            break;
+        }
     }
+    return readSize;
+}
 
-    const uint32_t numberItems = itemsCount();
-    if ( index >= numberItems ) {
-        throw BitException( "Cannot extract the item at the index " + std::to_string( index ) + " to the buffer",
+auto BitInputArchive::readRange( uint32_t index,
+                                 uint64_t offset,
+                                 std::size_t length,
+                                 std::vector< byte_t >& outBuffer ) const -> bool {
+    CMyComPtr< IInArchiveGetStream > getStream;
+    if ( mInArchive->QueryInterface( ::IID_IInArchiveGetStream, reinterpret_cast< void** >( &getStream ) ) != S_OK ) {
+        return false; // The archive format doesn't provide direct access to the items' data.
+    }
+
+    CMyComPtr< ISequentialInStream > itemStream;
+    if ( getStream->GetStream( index, &itemStream ) != S_OK || itemStream == nullptr ) {
+        return false; // The item's data is not directly accessible (e.g., it is compressed or encrypted).
+    }
+
+    CMyComPtr< IInStream > seekableStream;
+    const HRESULT res = itemStream->QueryInterface( ::IID_IInStream, reinterpret_cast< void** >( &seekableStream ) );
+    if ( res != S_OK || offset > static_cast< uint64_t >( std::numeric_limits< Int64 >::max() ) ||
+         seekableStream->Seek( static_cast< Int64 >( offset ), STREAM_SEEK_SET, nullptr ) != S_OK ) {
+        // Skipping the data before the range, using the output buffer as scratch space.
+        uint64_t skippedSize = 0;
+        while ( skippedSize < offset ) {
+            const auto chunkSize = static_cast< std::size_t >( std::min< uint64_t >( offset - skippedSize,
+                                                                                     kRangeChunkSize ) );
+            const std::size_t chunkReadSize = append_item_stream( itemStream, outBuffer, chunkSize );
+            outBuffer.clear();
+            if ( chunkReadSize == 0 ) { // The range starts after the end of the item.
+                return true;
+            }
+            skippedSize += chunkReadSize;
+        }
+    }
+    append_item_stream( itemStream, outBuffer, length );
+    return true;
+}
+
+void BitInputArchive::extractRange( uint32_t index,
+                                    uint64_t offset,
+                                    std::size_t length,
+                                    std::vector< byte_t >& outBuffer ) const {
+    if ( index >= itemsCount() ) {
+        throw BitException( "Cannot extract item at the index " + std::to_string( index ),
                             make_error_code( BitError::InvalidIndex ) );
     }
 
     if ( isItemFolder( index ) ) { // Consider only files, not folders
-        throw BitException( "Cannot extract the item at the index " + std::to_string( index ) + " to the buffer",
+        throw BitException( "Cannot extract item at the index " + std::to_string( index ) + " to the buffer",
                             make_error_code( BitError::ItemIsAFolder ) );
     }
 
-    auto itemSize = itemProperty( index, BitProperty::Size ).getUInt64();
-    if ( size != itemSize ) {
-        throw BitException( "Cannot extract archive to pre-allocated buffer",
-                            make_error_code( BitError::InvalidOutputBufferSize ) );
+    outBuffer.clear();
+    if ( length == 0 ) {
+        return;
     }
 
-    const vector< uint32_t > indices( 1, index );
-    auto extractCallback = bit7z::make_com< FixedBufferExtractCallback, ExtractCallback >( *this, buffer, size );
+    // The range can't be larger than the item, so we reserve at most the declared size of its data after the offset.
+    const BitPropVariant sizeProp = itemProperty( index, BitProperty::Size );
+    if ( sizeProp.isUInt64() && sizeProp.getUInt64() > offset ) {
+        const uint64_t rangeSize = std::min< uint64_t >( sizeProp.getUInt64() - offset, length );
+        outBuffer.reserve( static_cast< std::size_t >( rangeSize ) );
+    }
+
+    if ( readRange( index, offset, length, outBuffer ) ) {
+        return;
+    }
+
+    // Decoding the item, discarding the data before the range, and stopping as soon as the range is filled.
+
+    uint64_t position = 0;
+    ExtractSink sink;
+    sink.onData = [ &outBuffer, &position, offset, length ]( uint32_t, const byte_t* data, std::size_t size ) -> bool {
+        const uint64_t chunkEnd = position + size;
+        if ( chunkEnd > offset ) {
+            const auto skippedSize = static_cast< std::size_t >( offset > position ? offset - position : 0 );
+            const std::size_t copiedSize = std::min( size - skippedSize, length - outBuffer.size() );
+            outBuffer.insert( outBuffer.end(), data + skippedSize, data + skippedSize + copiedSize ); //-V2563
+        }
+        position = chunkEnd;
+        return outBuffer.size() < length;
+    };
+
+    try {
+        extractTo( sink, { index } );
+    } catch ( const BitException& ) {
+        if ( outBuffer.size() < length ) {
+            throw;
+        }
+        // Otherwise, the extraction was aborted by the sink since the range was filled.
+    }
+}
+
+void BitInputArchive::extractTo( byte_t* buffer, std::size_t size, uint32_t index ) const {
+    extractTo( std::vector< ItemBuffer >{ ItemBuffer{ index, buffer, size } } );
+}
+
+void BitInputArchive::extractTo( const std::vector< ItemBuffer >& itemBuffers ) const {
+    const uint32_t numberItems = itemsCount();
+    for ( const auto& itemBuffer : itemBuffers ) {
+        const auto index = itemBuffer.index;
+        if ( itemBuffer.buffer == nullptr && itemBuffer.size > 0 ) { // Note: empty items need no buffer.
+            throw BitException( "Cannot extract the item at the index " + std::to_string( index ) + " to the buffer",
+                                make_error_code( BitError::NullOutputBuffer ) );
+        }
+
+        if ( index >= numberItems ) {
+            throw BitException( "Cannot extract the item at the index " + std::to_string( index ) + " to the buffer",
+                                make_error_code( BitError::InvalidIndex ) );
+        }
+
+        if ( isItemFolder( index ) ) { // Consider only files, not folders
+            throw BitException( "Cannot extract the item at the index " + std::to_string( index ) + " to the buffer",
+                                make_error_code( BitError::ItemIsAFolder ) );
+        }
+
+        auto itemSize = itemProperty( index, BitProperty::Size ).getUInt64();
+        if ( itemBuffer.size != itemSize ) {
+            throw BitException( "Cannot extract archive to pre-allocated buffer",
+                                make_error_code( BitError::InvalidOutputBufferSize ) );
+        }
+    }
+
+    // 7-Zip requires the indices of the items to be extracted to be sorted in ascending order.
+    std::vector< ItemBuffer > sortedBuffers = itemBuffers;
+    std::sort( sortedBuffers.begin(), sortedBuffers.end(),
+               []( const ItemBuffer& first, const ItemBuffer& second ) -> bool {
+                   return first.index < second.index;
+               } );
+    const auto sameIndex = []( const ItemBuffer& first, const ItemBuffer& second ) -> bool {
+        return first.index == second.index;
+    };
+    const auto duplicate = std::adjacent_find( sortedBuffers.cbegin(), sortedBuffers.cend(), sameIndex );
+    if ( duplicate != sortedBuffers.cend() ) {
+        throw BitException( "Cannot extract the item at the index " + std::to_string( duplicate->index ) +
+                            " to multiple buffers", make_error_code( BitError::InvalidIndex ) );
+    }
+
+    vector< uint32_t > indices;
+    indices.reserve( sortedBuffers.size() );
+    for ( const auto& itemBuffer : sortedBuffers ) {
+        indices.push_back( itemBuffer.index );
+    }
+    if ( indices.empty() ) {
+        return; // Note: an empty indices vector would make 7-Zip extract all the items.
+    }
+
+    auto extractCallback = bit7z::make_com< FixedBufferExtractCallback, ExtractCallback >( *this,
+                                                                                          std::move( sortedBuffers ) );
     extract_arc( mInArchive, indices, extractCallback );
 }
 
 void BitInputArchive::extractTo( std::map< tstring, std::vector< byte_t > >& outMap ) const {
-    const uint32_t numberItems = itemsCount();
+    extractTo( outMap, {} );
+}
+
+void BitInputArchive::extractTo( std::map< tstring, std::vector< byte_t > >& outMap,
+                                 const std::vector< uint32_t >& indices ) const {
+    const auto invalidIndex = findInvalidIndex( indices, itemsCount() );
+    if ( invalidIndex != indices.cend() ) {
+        throw BitException( "Cannot extract item at the index " + std::to_string( *invalidIndex ),
+                            make_error_code( BitError::InvalidIndex ) );
+    }
+
     vector< uint32_t > filesIndices;
-    for ( uint32_t i = 0; i < numberItems; ++i ) {
-        if ( !isItemFolder( i ) ) { // Consider only files, not folders
-            filesIndices.push_back( i );
+    if ( indices.empty() ) {
+        const uint32_t numberItems = itemsCount();
+        for ( uint32_t i = 0; i < numberItems; ++i ) {
+            if ( !isItemFolder( i ) ) { // Consider only files, not folders
+                filesIndices.push_back( i );
+            }
         }
+    } else {
+        std::copy_if( indices.cbegin(), indices.cend(), std::back_inserter( filesIndices ),
+                      [ this ]( uint32_t index ) -> bool {
+                          return !isItemFolder( index ); // Consider only files, not folders
+                      } );
+        // 7-Zip requires the indices of the items to be extracted to be sorted in ascending order.
+        std::sort( filesIndices.begin(), filesIndices.end() );
+        filesIndices.erase( std::unique( filesIndices.begin(), filesIndices.end() ), filesIndices.end() );
+    }
+
+    if ( filesIndices.empty() ) {
+        return; // Note: an empty indices vector would make 7-Zip extract all the items.
     }
 
     auto extractCallback = bit7z::make_com< BufferExtractCallback, ExtractCallback >( *this, outMap );
     extract_arc( mInArchive, filesIndices, extractCallback );
 }
 
+void BitInputArchive::extractTo( BitExtractedData& outData ) const {
+    outData.clear();
+    auto& entries = outData.mEntries;
+
+    // Collecting the paths of all the files into the string pool.
+    const uint32_t numberItems = itemsCount();
+    entries.reserve( numberItems );
+    for ( uint32_t index = 0; index < numberItems; ++index ) {
+        if ( isItemFolder( index ) ) { // Consider only files, not folders
+            continue;
+        }
+
+        const BitPropVariant pathProp = itemProperty( index, BitProperty::Path );
+        tstring itemPath;
+        if ( pathProp.isEmpty() ) {
+            itemPath = kEmptyFileAlias;
+        } else if ( !mArchiveHandler.retainDirectories() ) {
+            itemPath = path_to_tstring( fs::path{ pathProp.getNativeString() }.filename() );
+        } else {
+            itemPath = pathProp.getString();
+        }
+
+        entries.push_back( { index, outData.mPaths.size(), itemPath.size(), 0, 0 } );
+        outData.mPaths += itemPath;
+    }
+
+    // Sorting the index by path, resolving the files having the same path according to the overwrite mode.
+    using Entry = BitExtractedData::Entry;
+    std::stable_sort( entries.begin(), entries.end(),
+                      [ &outData ]( const Entry& first, const Entry& second ) -> bool {
+                          return outData.comparePaths( first, second ) < 0;
+                      } );
+    const auto samePath = [ &outData ]( const Entry& first, const Entry& second ) -> bool {
+        return outData.comparePaths( first, second ) == 0;
+    };
+    if ( std::adjacent_find( entries.cbegin(), entries.cend(), samePath ) != entries.cend() ) {
+        switch ( mArchiveHandler.overwriteMode() ) {
+            case OverwriteMode::None: {
+                throw BitException( "Cannot erase output buffer", make_hresult_code( E_ABORT ) );
+            }
+            case OverwriteMode::Skip: { // Keeping the first file having a given path.
+                entries.erase( std::unique( entries.begin(), entries.end(), samePath ), entries.end() );
+                break;
+            }
+            case OverwriteMode::Overwrite:
+            default: { // Keeping the last file having a given path.
+                std::reverse( entries.begin(), entries.end() );
+                entries.erase( std::unique( entries.begin(), entries.end(), samePath ), entries.end() );
+                std::reverse( entries.begin(), entries.end() );
+                break;
+            }
+        }
+    }
+
+    // The items are extracted in ascending index order, each one appending its data to the arena.
+    std::vector< std::size_t > extractionOrder( entries.size() );
+    for ( std::size_t position = 0; position < extractionOrder.size(); ++position ) {
+        extractionOrder[ position ] = position;
+    }
+    std::sort( extractionOrder.begin(), extractionOrder.end(),
+               [ &entries ]( std::size_t first, std::size_t second ) -> bool {
+                   return entries[ first ].index < entries[ second ].index;
+               } );
+    std::vector< uint32_t > indices;
+    indices.reserve( entries.size() );
+    uint64_t totalSize = 0; // Note: only the items actually extracted (i.e., after resolving duplicates) count.
+    for ( const auto position : extractionOrder ) {
+        indices.push_back( entries[ position ].index );
+
+        const BitPropVariant sizeProp = itemProperty( entries[ position ].index, BitProperty::Size );
+        if ( sizeProp.isUInt64() ) {
+            totalSize += sizeProp.getUInt64();
+        }
+    }
+    if ( indices.empty() ) {
+        return;
+    }
+
+    try {
+        if ( totalSize <= outData.mArena.max_size() ) {
+            outData.mArena.reserve( static_cast< std::size_t >( totalSize ) );
+        }
+    } catch ( ... ) {
+        // The declared sizes might be bogus (e.g., in corrupted archives): we just let the arena grow as needed.
+    }
+
+    Entry* currentEntry = nullptr;
+    ExtractSink sink;
+    sink.onItemBegin = [ &outData, &entries, &indices, &extractionOrder, &currentEntry ]( uint32_t index ) {
+        const auto found = std::lower_bound( indices.cbegin(), indices.cend(), index );
+        currentEntry = &entries[ extractionOrder[ static_cast< std::size_t >( found - indices.cbegin() ) ] ];
+        currentEntry->dataOffset = outData.mArena.size();
+    };
+    sink.onData = [ &outData ]( uint32_t, const byte_t* data, std::size_t size ) -> bool {
+        outData.mArena.insert( outData.mArena.end(), data, data + size ); //-V2563
+        return true;
+    };
+    sink.onItemEnd = [ &outData, &currentEntry ]( uint32_t, bool ) {
+        currentEntry->dataSize = outData.mArena.size() - currentEntry->dataOffset;
+    };
+
+    try {
+        extractTo( sink, indices );
+    } catch ( ... ) {
+        outData.clear();
+        throw;
+    }
+}
+
+void BitInputArchive::extractTo( const ExtractSink& sink, const std::vector< uint32_t >& indices ) const {
+    if ( !sink.onData ) {
+        throw BitException( "Cannot extract the archive to the sink",
+                            std::make_error_code( std::errc::invalid_argument ) );
+    }
+
+    const auto invalidIndex = findInvalidIndex( indices, itemsCount() );
+    if ( invalidIndex != indices.cend() ) {
+        throw BitException( "Cannot extract item at the index " + std::to_string( *invalidIndex ),
+                            make_error_code( BitError::InvalidIndex ) );
+    }
+
+    auto extractCallback = bit7z::make_com< SinkExtractCallback >( *this, sink );
+    try {
+        extract_arc( mInArchive, indices, extractCallback );
+    } catch ( const BitException& ) {
+        // The extraction failed because of an exception thrown by the user's callbacks: we rethrow it as is.
+        if ( extractCallback->sinkException() ) {
+            std::rethrow_exception( extractCallback->sinkException() );
+        }
+        throw;
+    }
+}
+
 void BitInputArchive::test() const {
     map< tstring, vector< byte_t > > dummyMap; // output map (not used since we are testing!)
     auto extractCallback = bit7z::make_com< BufferExtractCallback, ExtractCallback >( *this, dummyMap );
@@ -370,10 +942,34 @@ auto BitInputArchive::cend() const noexcept -> BitInputArchive::ConstIterator {
     return end();
 }
 
+inline auto normalize_item_path( tstring path ) -> tstring {
+#if defined( _WIN32 )
+    std::replace( path.begin(), path.end(), BIT7Z_STRING( '/' ), BIT7Z_STRING( '\\' ) );
+#endif
+    return path;
+}
+
 auto BitInputArchive::find( const tstring& path ) const noexcept -> BitInputArchive::ConstIterator {
-    return std::find_if( begin(), end(), [ &path ]( auto& oldItem ) {
-        return oldItem.path() == path;
-    } );
+    try {
+        const std::lock_guard< std::mutex > lock{ mPathIndexMutex };
+        if ( !mPathIndexBuilt ) {
+            mPathIndex.clear();
+            mPathIndex.reserve( itemsCount() );
+            for ( const auto& item : *this ) {
+                // Note: emplace doesn't replace existing keys, so the first item with a given path is kept.
+                mPathIndex.emplace( normalize_item_path( item.path() ), item.index() );
+            }
+            mPathIndexBuilt = true;
+        }
+        const auto indexedItem = mPathIndex.find( normalize_item_path( path ) );
+        return indexedItem != mPathIndex.cend() ? ConstIterator{ indexedItem->second, *this } : end();
+    } catch ( const std::exception& ) {
+        // The index could not be built (e.g., the archive's items could not be read): searching linearly.
+        const tstring itemPath = normalize_item_path( path );
+        return std::find_if( begin(), end(), [ &itemPath ]( auto& oldItem ) -> bool {
+            return normalize_item_path( oldItem.path() ) == itemPath;
+        } );
+    }
 }
 
 auto BitInputArchive::contains( const tstring& path ) const noexcept -> bool {
@@ -16,6 +16,8 @@
 #include "internal/archiveproperties.hpp"
 #include "internal/cbufferoutstream.hpp"
 #include "internal/cmultivolumeoutstream.hpp"
+#include "internal/cstdoutstream.hpp"
+#include "internal/filestreams.hpp"
 #include "internal/genericinputitem.hpp"
 #include "internal/stringutil.hpp"
 #include "internal/updatecallback.hpp"
@@ -59,8 +61,7 @@ BitOutputArchive::BitOutputArchive( const BitAbstractArchiveCreator& creator, co
     mInputArchiveItemsCount = mInputArchive->itemsCount();
 }
 
-BitOutputArchive::BitOutputArchive( const BitAbstractArchiveCreator& creator,
-                                    const std::vector< bit7z::byte_t >& inBuffer )
+BitOutputArchive::BitOutputArchive( const BitAbstractArchiveCreator& creator, BufferView inBuffer )
     : mArchiveCreator{ creator }, mInputArchiveItemsCount{ 0 } {
     if ( !inBuffer.empty() ) {
         mInputArchive = std::make_unique< BitInputArchive >( creator, inBuffer );
@@ -95,7 +96,7 @@ void BitOutputArchive::addFile( const tstring& inFile, const tstring& name ) {
                                !mArchiveCreator.storeSymbolicLinks() );
 }
 
-void BitOutputArchive::addFile( const std::vector< byte_t >& inBuffer, const tstring& name ) {
+void BitOutputArchive::addFile( BufferView inBuffer, const tstring& name ) {
     mNewItemsVector.indexBuffer( inBuffer, name );
 }
 
@@ -154,7 +155,7 @@ auto BitOutputArchive::initOutFileStream( const fs::path& outArchive,
         outPath += ".tmp";
     }
 
-    return bit7z::make_com< CFileOutStream, IOutStream >( outPath, updatingArchive );
+    return bit7z::make_com< FileOutStream, IOutStream >( outPath, updatingArchive );
 }
 
 void BitOutputArchive::compressOut( IOutArchive* outArc,
@@ -232,7 +233,7 @@ void BitOutputArchive::compressTo( const tstring& outFile ) {
         if ( overwriteMode == OverwriteMode::Overwrite && !fs::remove( outPath, error ) ) {
             throw BitException( "Failed to delete the old archive file", error, outFile );
         }
-        // Note: if overwriteMode is OverwriteMode::None, an exception will be thrown by the CFileOutStream constructor
+        // Note: if overwriteMode is OverwriteMode::None, an exception will be thrown by the FileOutStream constructor
         // called by the initOutFileStream function.
     }
 
@@ -0,0 +1,112 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "internal/asyncwriterpool.hpp"
+#include "internal/fsutil.hpp"
+
+#include <functional>
+#include <string>
+#include <utility>
+
+namespace bit7z {
+
+AsyncWriterPool::AsyncWriterPool( std::size_t threadsCount, std::size_t maxPendingBytes )
+    : mMaxPendingBytes{ maxPendingBytes },
+      mPendingBytes{ 0 },
+      mPendingTasks{ 0 },
+      mFailed{ false },
+      mStopping{ false },
+      mLanes( threadsCount > 0 ? threadsCount : 1 ) {
+    mThreads.reserve( mLanes.size() );
+    for ( std::size_t lane = 0; lane < mLanes.size(); ++lane ) {
+        mThreads.emplace_back( &AsyncWriterPool::runLane, this, lane );
+    }
+}
+
+AsyncWriterPool::~AsyncWriterPool() {
+    {
+        const std::lock_guard< std::mutex > lock{ mMutex };
+        mStopping = true;
+    }
+    mTaskPosted.notify_all();
+    for ( auto& thread : mThreads ) {
+        thread.join();
+    }
+}
+
+auto AsyncWriterPool::laneFor( const fs::path& filePath ) const -> std::size_t {
+    // Note: paths differing only by case might refer to the same file (e.g., on Windows), so they share the lane.
+    return std::hash< std::wstring >{}( filesystem::fsutil::case_folded_path( filePath ) ) % mLanes.size();
+}
+
+void AsyncWriterPool::post( std::size_t lane, std::function< void() > task, std::size_t taskBytes ) {
+    {
+        std::unique_lock< std::mutex > lock{ mMutex };
+        // Note: a task is always accepted when nothing is pending, even if it is larger than the limit.
+        mTaskCompleted.wait( lock, [ this, taskBytes ]() -> bool {
+            return mPendingBytes == 0 || mPendingBytes + taskBytes <= mMaxPendingBytes;
+        } );
+        mLanes[ lane ].push_back( Task{ std::move( task ), taskBytes } );
+        mPendingBytes += taskBytes;
+        ++mPendingTasks;
+    }
+    mTaskPosted.notify_all();
+}
+
+auto AsyncWriterPool::failed() const noexcept -> bool {
+    return mFailed;
+}
+
+void AsyncWriterPool::finish() {
+    std::unique_lock< std::mutex > lock{ mMutex };
+    mTaskCompleted.wait( lock, [ this ]() -> bool {
+        return mPendingTasks == 0;
+    } );
+    if ( mError ) {
+        std::rethrow_exception( mError );
+    }
+}
+
+void AsyncWriterPool::runLane( std::size_t lane ) {
+    std::unique_lock< std::mutex > lock{ mMutex };
+    auto& tasks = mLanes[ lane ];
+    while ( true ) {
+        mTaskPosted.wait( lock, [ this, &tasks ]() -> bool {
+            return mStopping || !tasks.empty();
+        } );
+        if ( tasks.empty() ) { // Stopping, and no more tasks to be run.
+            return;
+        }
+
+        Task task = std::move( tasks.front() );
+        tasks.pop_front();
+        lock.unlock();
+        if ( !mFailed ) { // After a failure, the remaining tasks are just discarded.
+            try {
+                task.run();
+            } catch ( ... ) {
+                const std::lock_guard< std::mutex > errorLock{ mMutex };
+                if ( !mError ) {
+                    mError = std::current_exception();
+                }
+                mFailed = true;
+            }
+        }
+        task.run = nullptr; // Releasing the task's data before accounting it as completed.
+        lock.lock();
+        mPendingBytes -= task.bytes;
+        --mPendingTasks;
+        mTaskCompleted.notify_all();
+    }
+}
+
+} // namespace bit7z
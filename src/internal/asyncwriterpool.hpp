@@ -0,0 +1,103 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef ASYNCWRITERPOOL_HPP
+#define ASYNCWRITERPOOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "bitdefines.hpp"
+#include "internal/fs.hpp"
+
+namespace bit7z {
+
+/**
+ * @brief A small pool of threads performing the filesystem work of an extraction
+ *        (i.e., creating, writing, and closing the output files), while the decoder keeps decoding.
+ *
+ * Tasks are posted to lanes, each one served by a single thread, so the tasks posted to the same lane
+ * (e.g., all the operations on the same output file) are executed in order.
+ * The lane of a file depends only on its path, so the operations on files with the same path
+ * (e.g., multiple versions of a file in a tar archive) are executed in order, too.
+ * The data held by the pending tasks is bounded: posting a task blocks the caller until there's enough room for it.
+ */
+class AsyncWriterPool final {
+    public:
+        static constexpr std::size_t kMaxPendingBytes = 64 * 1024 * 1024;
+
+        explicit AsyncWriterPool( std::size_t threadsCount, std::size_t maxPendingBytes = kMaxPendingBytes );
+
+        AsyncWriterPool( const AsyncWriterPool& ) = delete;
+
+        AsyncWriterPool( AsyncWriterPool&& ) = delete;
+
+        auto operator=( const AsyncWriterPool& ) -> AsyncWriterPool& = delete;
+
+        auto operator=( AsyncWriterPool&& ) -> AsyncWriterPool& = delete;
+
+        ~AsyncWriterPool();
+
+        /**
+         * @param filePath  the path of an output file.
+         *
+         * @return the lane to be used for the tasks of the output file with the given path.
+         */
+        BIT7Z_NODISCARD auto laneFor( const fs::path& filePath ) const -> std::size_t;
+
+        /**
+         * @brief Posts a task to the given lane, blocking while the pending data would exceed the pool's limit.
+         *
+         * @param lane        the lane the task must be executed on.
+         * @param task        the task to be executed.
+         * @param taskBytes   the size of the data held by the task.
+         */
+        void post( std::size_t lane, std::function< void() > task, std::size_t taskBytes = 0 );
+
+        /**
+         * @return whether a task failed (in which case, all the following tasks are discarded).
+         */
+        BIT7Z_NODISCARD auto failed() const noexcept -> bool;
+
+        /**
+         * @brief Waits for all the pending tasks to complete, rethrowing the exception of the first failed task.
+         */
+        void finish();
+
+    private:
+        struct Task {
+            std::function< void() > run;
+            std::size_t bytes;
+        };
+
+        std::size_t mMaxPendingBytes;
+        std::size_t mPendingBytes;
+        std::size_t mPendingTasks;
+        std::atomic< bool > mFailed;
+        bool mStopping;
+        std::exception_ptr mError;
+        std::vector< std::deque< Task > > mLanes;
+        std::mutex mMutex;
+        std::condition_variable mTaskPosted;
+        std::condition_variable mTaskCompleted;
+        std::vector< std::thread > mThreads;
+
+        void runLane( std::size_t lane );
+};
+
+}  // namespace bit7z
+
+#endif // ASYNCWRITERPOOL_HPP
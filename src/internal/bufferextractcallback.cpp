@@ -10,6 +10,8 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 
+#include <algorithm>
+
 #include "bitexception.hpp"
 #include "internal/bufferextractcallback.hpp"
 #include "internal/cbufferoutstream.hpp"
@@ -26,6 +28,22 @@ BufferExtractCallback::BufferExtractCallback( const BitInputArchive& inputArchiv
     : ExtractCallback( inputArchive ),
       mBuffersMap( buffersMap ) {}
 
+/* Upper bound of the memory reserved up-front for an item: the declared size is not trustworthy
+ * (e.g., it might be bogus in corrupted or malicious archives), so larger items grow the buffer as needed. */
+constexpr uint64_t kMaxBufferReservation = 256ull * 1024 * 1024;
+
+inline void reserve_buffer( vector< byte_t >& buffer, uint64_t size ) noexcept {
+    const uint64_t reservation = ( std::min )( size, kMaxBufferReservation );
+    if ( reservation > buffer.max_size() ) {
+        return;
+    }
+    try {
+        buffer.reserve( static_cast< vector< byte_t >::size_type >( reservation ) );
+    } catch ( ... ) {
+        // The declared size might be bogus (e.g., in corrupted archives): we just let the buffer grow as needed.
+    }
+}
+
 void BufferExtractCallback::releaseStream() {
     mOutMemStream.Release();
 }
@@ -73,6 +91,13 @@ auto BufferExtractCallback::getOutStream( uint32_t index, ISequentialOutStream**
         }
     }
 
+    /* Reserving the space for the whole item, if its size is known, so that writing the extracted data
+     * will not need to reallocate (and copy) the buffer multiple times. */
+    const BitPropVariant sizeProp = itemProperty( index, BitProperty::Size );
+    if ( sizeProp.isUInt64() ) {
+        reserve_buffer( outBuffer, sizeProp.getUInt64() );
+    }
+
     auto outStreamLoc = bit7z::make_com< CBufferOutStream, ISequentialOutStream >( outBuffer );
     mOutMemStream = outStreamLoc;
     *outStream = outStreamLoc.Detach();
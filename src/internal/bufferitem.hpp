@@ -16,11 +16,9 @@
 
 namespace bit7z {
 
-using std::vector;
-
 class BufferItem final : public GenericInputItem {
     public:
-        explicit BufferItem( const vector< byte_t >& buffer, fs::path name );
+        explicit BufferItem( BufferView buffer, fs::path name );
 
         BIT7Z_NODISCARD auto name() const -> tstring override;
 
@@ -43,7 +41,7 @@ class BufferItem final : public GenericInputItem {
         BIT7Z_NODISCARD auto attributes() const noexcept -> uint32_t override;
 
     private:
-        const vector< byte_t >& mBuffer;
+        BufferView mBuffer;
         fs::path mBufferName;
 };
 
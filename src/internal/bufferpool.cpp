@@ -0,0 +1,180 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "internal/bufferpool.hpp"
+#include "internal/filehandle.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace bit7z {
+
+namespace {
+// The alignment of the storage returned by operator new[] (i.e., the one we get without any padding).
+constexpr std::size_t kDefaultAlignment = alignof( std::max_align_t );
+
+constexpr auto storage_padding( std::size_t alignment ) noexcept -> std::size_t {
+    return alignment > kDefaultAlignment ? alignment - 1 : 0;
+}
+} // namespace
+
+AlignedBuffer::AlignedBuffer( std::size_t size, std::size_t alignment )
+    : mStorage{ new byte_t[ size + storage_padding( alignment ) ] }, // NOLINT(*-avoid-c-arrays)
+      mData{ nullptr },
+      mSize{ size } {
+    // Note: when needed, the storage is over-allocated so that there's always room for an aligned start.
+    const auto address = reinterpret_cast< std::uintptr_t >( mStorage.get() ); // NOLINT(*-reinterpret-cast)
+    const auto padding = static_cast< std::size_t >( ( alignment - ( address % alignment ) ) % alignment );
+    mData = mStorage.get() + padding; //-V2563
+}
+
+auto AlignedBuffer::data() noexcept -> byte_t* {
+    return mData;
+}
+
+auto AlignedBuffer::size() const noexcept -> std::size_t {
+    return mSize;
+}
+
+auto AlignedBuffer::isAligned( std::size_t alignment ) const noexcept -> bool {
+    return reinterpret_cast< std::uintptr_t >( mData ) % alignment == 0; // NOLINT(*-reinterpret-cast)
+}
+
+PooledBuffer::PooledBuffer( std::unique_ptr< AlignedBuffer > buffer ) noexcept : mBuffer{ std::move( buffer ) } {}
+
+auto PooledBuffer::operator=( PooledBuffer&& other ) noexcept -> PooledBuffer& {
+    if ( this != &other ) {
+        reset();
+        mBuffer = std::move( other.mBuffer );
+    }
+    return *this;
+}
+
+PooledBuffer::~PooledBuffer() {
+    reset();
+}
+
+auto PooledBuffer::data() noexcept -> byte_t* {
+    return mBuffer ? mBuffer->data() : nullptr;
+}
+
+auto PooledBuffer::size() const noexcept -> std::size_t {
+    return mBuffer ? mBuffer->size() : 0;
+}
+
+auto PooledBuffer::empty() const noexcept -> bool {
+    return mBuffer == nullptr;
+}
+
+void PooledBuffer::reset() noexcept {
+    if ( mBuffer ) {
+        BufferPool::release( std::move( mBuffer ) );
+        mBuffer = nullptr;
+    }
+}
+
+namespace {
+// Size classes: 4 KiB, 16 KiB, 64 KiB, 256 KiB, and 1 MiB.
+constexpr std::size_t kSizeClassesCount = 5;
+constexpr std::size_t kSizeClassFactorBits = 2;
+
+auto size_class_of( std::size_t size ) noexcept -> std::size_t {
+    std::size_t sizeClass = 0;
+    std::size_t classSize = BufferPool::kMinBufferSize;
+    while ( classSize < size && sizeClass < kSizeClassesCount - 1 ) {
+        classSize <<= kSizeClassFactorBits;
+        ++sizeClass;
+    }
+    return sizeClass;
+}
+
+constexpr auto size_of_class( std::size_t sizeClass ) noexcept -> std::size_t {
+    return BufferPool::kMinBufferSize << ( sizeClass * kSizeClassFactorBits );
+}
+
+struct BuffersCache {
+    std::array< std::vector< std::unique_ptr< AlignedBuffer > >, kSizeClassesCount > freeBuffers;
+    std::size_t cachedBytes = 0;
+};
+
+auto thread_cache() noexcept -> BuffersCache& {
+    thread_local BuffersCache cache;
+    return cache;
+}
+} // namespace
+
+auto BufferPool::acquire( std::size_t size ) -> PooledBuffer {
+    return acquire( size, kDefaultAlignment );
+}
+
+auto BufferPool::acquireAligned( std::size_t size ) -> PooledBuffer {
+    return acquire( size, FileHandle::kUnbufferedAlignment );
+}
+
+auto BufferPool::acquire( std::size_t size, std::size_t alignment ) -> PooledBuffer {
+    const std::size_t sizeClass = size_class_of( size );
+    auto& cache = thread_cache();
+    auto& freeBuffers = cache.freeBuffers[ sizeClass ];
+    // Note: buffers allocated without padding might still be aligned by chance (e.g., if allocated via mmap).
+    const auto found = std::find_if( freeBuffers.rbegin(), freeBuffers.rend(),
+                                     [ alignment ]( const std::unique_ptr< AlignedBuffer >& buffer ) -> bool {
+                                         return buffer->isAligned( alignment );
+                                     } );
+    if ( found != freeBuffers.rend() ) {
+        auto buffer = std::move( *found );
+        freeBuffers.erase( std::next( found ).base() );
+        cache.cachedBytes -= buffer->size();
+        return PooledBuffer{ std::move( buffer ) };
+    }
+    return PooledBuffer{ std::make_unique< AlignedBuffer >( size_of_class( sizeClass ), alignment ) };
+}
+
+auto BufferPool::bufferSizeFor( std::uint64_t fileSize ) noexcept -> std::size_t {
+    return fileSize >= kMaxBufferSize ?
+           kMaxBufferSize :
+           size_of_class( size_class_of( static_cast< std::size_t >( fileSize ) ) );
+}
+
+void BufferPool::release( std::unique_ptr< AlignedBuffer > buffer ) noexcept {
+    const std::size_t bufferSize = buffer->size();
+    const std::size_t sizeClass = size_class_of( bufferSize );
+    if ( size_of_class( sizeClass ) != bufferSize ) {
+        return; // The buffer is simply freed.
+    }
+
+    auto& cache = thread_cache();
+    try {
+        cache.freeBuffers[ sizeClass ].push_back( std::move( buffer ) );
+        cache.cachedBytes += bufferSize;
+    } catch ( ... ) {
+        return; // Failed to cache the buffer, so it will simply be freed.
+    }
+
+    // Keeping the just released buffer (the most likely to be reused), and freeing the oldest of the largest ones.
+    std::size_t largestClass = kSizeClassesCount - 1;
+    while ( cache.cachedBytes > kMaxCachedBytes ) {
+        auto& freeBuffers = cache.freeBuffers[ largestClass ];
+        const std::size_t keptCount = largestClass == sizeClass ? 1 : 0;
+        if ( freeBuffers.size() <= keptCount ) {
+            --largestClass;
+            continue;
+        }
+        cache.cachedBytes -= freeBuffers.front()->size();
+        freeBuffers.erase( freeBuffers.begin() );
+    }
+}
+
+} // namespace bit7z
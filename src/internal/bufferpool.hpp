@@ -0,0 +1,109 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BUFFERPOOL_HPP
+#define BUFFERPOOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "bitdefines.hpp"
+#include "bittypes.hpp"
+
+namespace bit7z {
+
+/**
+ * A fixed-size, uninitialized memory buffer whose data is aligned to the given (power of two) alignment.
+ * Alignments not larger than the default one of operator new[] require no extra storage.
+ */
+class AlignedBuffer final {
+    public:
+        AlignedBuffer( std::size_t size, std::size_t alignment );
+
+        BIT7Z_NODISCARD auto data() noexcept -> byte_t*;
+
+        BIT7Z_NODISCARD auto size() const noexcept -> std::size_t;
+
+        BIT7Z_NODISCARD auto isAligned( std::size_t alignment ) const noexcept -> bool;
+
+    private:
+        std::unique_ptr< byte_t[] > mStorage; // NOLINT(*-avoid-c-arrays)
+        byte_t* mData;
+        std::size_t mSize;
+};
+
+/**
+ * A buffer borrowed from the BufferPool, which is given back to the pool when the object is destroyed.
+ */
+class PooledBuffer final {
+    public:
+        PooledBuffer() noexcept = default;
+
+        explicit PooledBuffer( std::unique_ptr< AlignedBuffer > buffer ) noexcept;
+
+        PooledBuffer( const PooledBuffer& ) = delete;
+
+        PooledBuffer( PooledBuffer&& ) noexcept = default;
+
+        auto operator=( const PooledBuffer& ) -> PooledBuffer& = delete;
+
+        auto operator=( PooledBuffer&& other ) noexcept -> PooledBuffer&;
+
+        ~PooledBuffer();
+
+        BIT7Z_NODISCARD auto data() noexcept -> byte_t*;
+
+        BIT7Z_NODISCARD auto size() const noexcept -> std::size_t;
+
+        BIT7Z_NODISCARD auto empty() const noexcept -> bool;
+
+        // Gives back the buffer to the pool.
+        void reset() noexcept;
+
+    private:
+        std::unique_ptr< AlignedBuffer > mBuffer;
+};
+
+/**
+ * A pool of the I/O buffers used by the file streams, so that reading or writing many files doesn't need to
+ * allocate and free a new buffer for each one of them.
+ *
+ * Buffers come in a few size classes (from kMinBufferSize to kMaxBufferSize), so that small files get small buffers;
+ * only the buffers used for unbuffered I/O need to be aligned to FileHandle::kUnbufferedAlignment.
+ * Free buffers are cached per thread (up to kMaxCachedBytes), so acquiring and releasing them never requires locking.
+ */
+class BufferPool final {
+    public:
+        static constexpr std::size_t kMinBufferSize = 4 * 1024; // 4 KiB
+        static constexpr std::size_t kMaxBufferSize = 1024 * 1024; // 1 MiB
+        static constexpr std::size_t kMaxCachedBytes = 2 * kMaxBufferSize; // Per thread.
+
+        BufferPool() = delete;
+
+        // Returns a buffer with the size class that best fits the requested size (capped to kMaxBufferSize).
+        static auto acquire( std::size_t size ) -> PooledBuffer;
+
+        // Same as acquire, but the buffer's data is aligned for unbuffered I/O.
+        static auto acquireAligned( std::size_t size ) -> PooledBuffer;
+
+        // Returns the size of the buffer to be used for reading or writing a file of the given size.
+        BIT7Z_NODISCARD static auto bufferSizeFor( std::uint64_t fileSize ) noexcept -> std::size_t;
+
+    private:
+        friend class PooledBuffer;
+
+        static auto acquire( std::size_t size, std::size_t alignment ) -> PooledBuffer;
+
+        static void release( std::unique_ptr< AlignedBuffer > buffer ) noexcept;
+};
+
+}  // namespace bit7z
+
+#endif //BUFFERPOOL_HPP
@@ -13,34 +13,46 @@
 #include "internal/bufferutil.hpp"
 #include "internal/windows.hpp"
 
-auto bit7z::seek( const buffer_t& buffer,
-                  const buffer_t::const_iterator& currentPosition,
+auto bit7z::seek( uint64_t bufferSize,
+                  uint64_t currentIndex,
                   int64_t offset,
                   uint32_t seekOrigin,
                   uint64_t& newPosition ) -> HRESULT {
-    uint64_t currentIndex{};
+    uint64_t seekIndex{};
     switch ( seekOrigin ) {
         case STREAM_SEEK_SET: {
             break;
         }
         case STREAM_SEEK_CUR: {
-            currentIndex = static_cast< uint64_t >( currentPosition - buffer.cbegin() );
+            seekIndex = currentIndex;
             break;
         }
         case STREAM_SEEK_END: {
-            currentIndex = static_cast< uint64_t >( buffer.cend() - buffer.cbegin() );
+            seekIndex = bufferSize;
             break;
         }
         default:
             return STG_E_INVALIDFUNCTION;
     }
 
-    RINOK( seek_to_offset( currentIndex, offset ) )
+    RINOK( seek_to_offset( seekIndex, offset ) )
 
-    if ( currentIndex > buffer.size() ) {
+    if ( seekIndex > bufferSize ) {
         return E_INVALIDARG;
     }
 
-    newPosition = currentIndex;
+    newPosition = seekIndex;
     return S_OK;
-}
\ No newline at end of file
+}
+
+auto bit7z::seek( const buffer_t& buffer,
+                  const buffer_t::const_iterator& currentPosition,
+                  int64_t offset,
+                  uint32_t seekOrigin,
+                  uint64_t& newPosition ) -> HRESULT {
+    return seek( static_cast< uint64_t >( buffer.size() ),
+                 static_cast< uint64_t >( currentPosition - buffer.cbegin() ),
+                 offset,
+                 seekOrigin,
+                 newPosition );
+}
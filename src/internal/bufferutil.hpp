@@ -15,6 +15,12 @@
 
 namespace bit7z {
 
+auto seek( uint64_t bufferSize,
+           uint64_t currentIndex,
+           int64_t offset,
+           uint32_t seekOrigin,
+           uint64_t& newPosition ) -> HRESULT;
+
 auto seek( const buffer_t& buffer,
            const buffer_t::const_iterator& currentPosition,
            int64_t offset,
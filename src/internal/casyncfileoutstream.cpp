@@ -0,0 +1,136 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <algorithm>
+#include <system_error>
+#include <utility>
+
+#include "bitexception.hpp"
+#include "internal/casyncfileoutstream.hpp"
+#include "internal/stringutil.hpp"
+#include "internal/util.hpp"
+
+namespace bit7z {
+
+inline auto chunk_capacity( uint64_t remainingSize ) -> std::size_t {
+    return static_cast< std::size_t >( std::min< uint64_t >( remainingSize, CAsyncFileOutStream::kChunkSize ) );
+}
+
+CAsyncFileOutStream::CAsyncFileOutStream( AsyncWriterPool& writerPool,
+                                          fs::path filePath,
+                                          uint64_t sizeHint,
+                                          OpenFunction openFile )
+    : mWriterPool{ writerPool },
+      mLane{ writerPool.laneFor( filePath ) },
+      mFile{ std::make_shared< OutputFile >() },
+      mRemainingSize{ sizeHint },
+      mClosed{ false } {
+    mFile->path = std::move( filePath );
+    mChunk.reserve( chunk_capacity( mRemainingSize ) );
+
+    auto file = mFile;
+    mWriterPool.post( mLane, [ file, openFile ]() {
+        file->stream = openFile();
+    } );
+}
+
+void CAsyncFileOutStream::postChunk() {
+    if ( mChunk.empty() ) {
+        return;
+    }
+
+    const std::size_t chunkSize = mChunk.size();
+    mRemainingSize -= std::min< uint64_t >( mRemainingSize, chunkSize );
+
+    auto file = mFile;
+    mWriterPool.post( mLane, [ file, chunk = std::move( mChunk ) ]() {
+        if ( file->stream == nullptr ) {
+            return; // The file was skipped.
+        }
+
+        const byte_t* data = chunk.data();
+        std::size_t remaining = chunk.size();
+        while ( remaining > 0 ) {
+            UInt32 written = 0;
+            const HRESULT res = file->stream->Write( data, clamp_cast< UInt32 >( remaining ), &written );
+            if ( res != S_OK || written == 0 ) {
+                throw BitException( "Could not write the extracted file",
+                                    make_hresult_code( res != S_OK ? res : E_FAIL ),
+                                    path_to_tstring( file->path ) );
+            }
+            data += written; //-V2563
+            remaining -= written;
+        }
+    }, chunkSize );
+
+    mChunk = std::vector< byte_t >{};
+    mChunk.reserve( chunk_capacity( mRemainingSize ) );
+}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CAsyncFileOutStream::Write( const void* data, UInt32 size, UInt32* processedSize ) noexcept try {
+    if ( processedSize != nullptr ) {
+        *processedSize = 0;
+    }
+
+    if ( mClosed || mWriterPool.failed() ) {
+        return E_ABORT;
+    }
+
+    const auto* bytes = static_cast< const byte_t* >( data );
+    mChunk.insert( mChunk.end(), bytes, bytes + size ); //-V2563
+    if ( mChunk.size() >= kChunkSize ) {
+        postChunk();
+    }
+
+    if ( processedSize != nullptr ) {
+        *processedSize = size;
+    }
+    return S_OK;
+} catch ( const std::bad_alloc& ) {
+    return E_OUTOFMEMORY;
+} catch ( const std::system_error& ) {
+    return E_FAIL;
+}
+
+auto CAsyncFileOutStream::close( CloseFunction beforeClose ) noexcept -> HRESULT try {
+    if ( mClosed || mWriterPool.failed() ) {
+        return E_ABORT;
+    }
+    mClosed = true;
+
+    postChunk();
+
+    auto file = mFile;
+    mWriterPool.post( mLane, [ file, beforeClose ]() {
+        if ( file->stream == nullptr ) {
+            return; // The file was skipped.
+        }
+
+        if ( file->stream->flush() != S_OK || file->stream->fail() ) {
+            throw BitException( "Could not write the extracted file",
+                                make_hresult_code( E_FAIL ),
+                                path_to_tstring( file->path ) );
+        }
+        if ( beforeClose ) {
+            beforeClose( file->stream );
+        }
+        file->stream.Release();
+    } );
+    return S_OK;
+} catch ( const std::bad_alloc& ) {
+    return E_OUTOFMEMORY;
+} catch ( const std::system_error& ) {
+    return E_FAIL;
+}
+
+} // namespace bit7z
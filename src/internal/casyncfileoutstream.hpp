@@ -0,0 +1,100 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CASYNCFILEOUTSTREAM_HPP
+#define CASYNCFILEOUTSTREAM_HPP
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "bittypes.hpp"
+#include "internal/asyncwriterpool.hpp"
+#include "internal/com.hpp"
+#include "internal/filestreams.hpp"
+#include "internal/fs.hpp"
+#include "internal/guids.hpp"
+#include "internal/macros.hpp"
+
+#include <7zip/IStream.h>
+
+namespace bit7z {
+
+/**
+ * @brief An output stream that collects the written data in bounded in-memory chunks,
+ *        leaving the actual file I/O (opening, writing, and closing the file) to an AsyncWriterPool.
+ *
+ * Errors occurring in the writer threads are reported by the AsyncWriterPool, and make the following writes fail.
+ */
+class CAsyncFileOutStream final : public ISequentialOutStream, public CMyUnknownImp {
+    public:
+        static constexpr std::size_t kChunkSize = 1024 * 1024;
+
+        /**
+         * @brief Function opening the output file in a writer thread; it returns a null stream if the file
+         *        must not be written (e.g., when skipping existing files).
+         */
+        using OpenFunction = std::function< CMyComPtr< FileOutStream >() >;
+
+        /**
+         * @brief Function run in a writer thread after the output file has been successfully written and flushed;
+         *        it receives the file's still open stream (e.g., to set the file metadata), and it may release it.
+         */
+        using CloseFunction = std::function< void( CMyComPtr< FileOutStream >& ) >;
+
+        CAsyncFileOutStream( AsyncWriterPool& writerPool,
+                             fs::path filePath,
+                             uint64_t sizeHint,
+                             OpenFunction openFile );
+
+        CAsyncFileOutStream( const CAsyncFileOutStream& ) = delete;
+
+        CAsyncFileOutStream( CAsyncFileOutStream&& ) = delete;
+
+        auto operator=( const CAsyncFileOutStream& ) -> CAsyncFileOutStream& = delete;
+
+        auto operator=( CAsyncFileOutStream&& ) -> CAsyncFileOutStream& = delete;
+
+        MY_UNKNOWN_VIRTUAL_DESTRUCTOR( ~CAsyncFileOutStream() ) = default;
+
+        /**
+         * @brief Posts the remaining data and the closing of the output file to the writer pool.
+         *
+         * @param beforeClose  the function to be run before the file is closed.
+         *
+         * @return S_OK if the closing was posted, an error code otherwise (e.g., if a previous write failed).
+         */
+        auto close( CloseFunction beforeClose ) noexcept -> HRESULT;
+
+        // ISequentialOutStream
+        BIT7Z_STDMETHOD( Write, void const* data, UInt32 size, UInt32* processedSize );
+
+        // NOLINTNEXTLINE(modernize-use-noexcept, modernize-use-trailing-return-type, readability-identifier-length)
+        MY_UNKNOWN_IMP1( ISequentialOutStream ) //-V2507 //-V2511 //-V835
+
+    private:
+        struct OutputFile {
+            fs::path path;
+            CMyComPtr< FileOutStream > stream;
+        };
+
+        AsyncWriterPool& mWriterPool;
+        std::size_t mLane;
+        std::shared_ptr< OutputFile > mFile;
+        std::vector< byte_t > mChunk;
+        uint64_t mRemainingSize;
+        bool mClosed;
+
+        void postChunk();
+};
+
+}  // namespace bit7z
+
+#endif // CASYNCFILEOUTSTREAM_HPP
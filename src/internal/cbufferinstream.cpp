@@ -23,7 +23,7 @@
 
 namespace bit7z {
 
-CBufferInStream::CBufferInStream( const vector< byte_t >& inBuffer )
+CBufferInStream::CBufferInStream( BufferView inBuffer )
     : mBuffer( inBuffer ), mCurrentPosition{ mBuffer.begin() } {}
 
 COM_DECLSPEC_NOTHROW
@@ -32,13 +32,13 @@ STDMETHODIMP CBufferInStream::Read( void* data, UInt32 size, UInt32* processedSi
         *processedSize = 0;
     }
 
-    if ( size == 0 || mCurrentPosition == mBuffer.cend() ) {
+    if ( size == 0 || mCurrentPosition == mBuffer.end() ) {
         return S_OK;
     }
 
-    /* Note: thanks to CBufferInStream::Seek, we can safely assume mCurrentPosition to always be a valid iterator;
+    /* Note: thanks to CBufferInStream::Seek, we can safely assume mCurrentPosition to always be a valid pointer;
      * so "remaining" will always be > 0 (and casts to unsigned types are safe) */
-    std::ptrdiff_t remaining = mBuffer.cend() - mCurrentPosition;
+    std::ptrdiff_t remaining = mBuffer.end() - mCurrentPosition;
     if ( cmp_greater( remaining, size ) ) {
         /* The remaining buffer still to read is bigger than the read size requested by the user,
          * so we need to read just a "size" number of bytes. */
@@ -63,15 +63,19 @@ STDMETHODIMP CBufferInStream::Read( void* data, UInt32 size, UInt32* processedSi
 COM_DECLSPEC_NOTHROW
 STDMETHODIMP CBufferInStream::Seek( Int64 offset, UInt32 seekOrigin, UInt64* newPosition ) noexcept {
     uint64_t newIndex{};
-    const HRESULT res = seek( mBuffer, mCurrentPosition, offset, seekOrigin, newIndex );
+    const HRESULT res = seek( static_cast< uint64_t >( mBuffer.size() ),
+                              static_cast< uint64_t >( mCurrentPosition - mBuffer.begin() ),
+                              offset,
+                              seekOrigin,
+                              newIndex );
 
     if ( res != S_OK ) {
         // The newIndex is not in the range [0, mBuffer.size]
         return res;
     }
 
-    // Note: newIndex can be equal to mBuffer.size(); in this case, mCurrentPosition == mBuffer.cend()
-    mCurrentPosition = mBuffer.cbegin() + static_cast< index_t >( newIndex );
+    // Note: newIndex can be equal to mBuffer.size(); in this case, mCurrentPosition == mBuffer.end()
+    mCurrentPosition = mBuffer.begin() + static_cast< index_t >( newIndex );
 
     if ( newPosition != nullptr ) {
         // Safe cast, since newIndex >= 0
@@ -19,11 +19,9 @@
 
 namespace bit7z {
 
-using std::vector;
-
 class CBufferInStream final : public IInStream, public CMyUnknownImp {
     public:
-        explicit CBufferInStream( const vector< byte_t >& inBuffer );
+        explicit CBufferInStream( BufferView inBuffer );
 
         CBufferInStream( const CBufferInStream& ) = delete;
 
@@ -44,8 +42,8 @@ class CBufferInStream final : public IInStream, public CMyUnknownImp {
         MY_UNKNOWN_IMP1( IInStream )  //-V2507 //-V2511 //-V835
 
     private:
-        const buffer_t& mBuffer;
-        buffer_t::const_iterator mCurrentPosition;
+        BufferView mBuffer;
+        const byte_t* mCurrentPosition;
 };
 
 }  // namespace bit7z
@@ -60,25 +60,22 @@ STDMETHODIMP CBufferOutStream::Write( const void* data, UInt32 size, UInt32* pro
         return E_FAIL;
     }
 
-    auto oldPos = ( mCurrentPosition - mBuffer.begin() );
-    const size_t newPos = static_cast< size_t >( oldPos ) + static_cast< size_t >( size );
-    if ( newPos > mBuffer.size() ) {
-        try {
-            mBuffer.resize( newPos );
-        } catch ( ... ) {
-            return E_OUTOFMEMORY;
-        }
-        mCurrentPosition = mBuffer.begin() + oldPos; // resize(...) invalidated the old mCurrentPosition iterator
-    }
-
+    const auto oldPos = ( mCurrentPosition - mBuffer.begin() );
     const auto* byteData = static_cast< const byte_t* >( data ); //-V2571
     try {
-        std::copy_n( byteData, size, mCurrentPosition );
+        /* Overwriting the bytes already in the buffer after the current position (if any),
+         * and appending the remaining ones: differently from resize(...), appending doesn't zero-fill
+         * the memory that we would overwrite right after. */
+        const auto overwriteSize = ( std::min )( static_cast< std::ptrdiff_t >( size ),
+                                                 mBuffer.end() - mCurrentPosition );
+        std::copy_n( byteData, overwriteSize, mCurrentPosition );
+        mBuffer.insert( mBuffer.end(), byteData + overwriteSize, byteData + size ); //-V2563
     } catch ( ... ) {
         return E_OUTOFMEMORY;
     }
 
-    std::advance( mCurrentPosition, clamp_cast< std::ptrdiff_t >( size ) );
+    // Note: appending to the buffer might have invalidated the old mCurrentPosition iterator.
+    mCurrentPosition = mBuffer.begin() + oldPos + clamp_cast< std::ptrdiff_t >( size );
 
     if ( processedSize != nullptr ) {
         *processedSize = size;
@@ -16,14 +16,21 @@
 
 namespace bit7z {
 
-CFileInStream::CFileInStream( const fs::path& filePath ) : CStdInStream( mFileStream ), mBuffer{} {
-    openFile( filePath );
-
+CFileInStream::CFileInStream( const fs::path& filePath ) : CStdInStream( mFileStream ) {
     /* By default, file stream performance is relatively poor due to the default buffer size used
      * (e.g., GCC uses a small 1024-bytes buffer).
      * This is a known problem (see https://stackoverflow.com/questions/26095160/why-are-stdfstreams-so-slow).
-     * We make the underlying file stream use a bigger buffer (1 MiB) for optimizing the reading of big files.  */
-    mFileStream.rdbuf()->pubsetbuf( mBuffer.data(), kBufferSize );
+     * We make the underlying file stream use a bigger buffer (up to 1 MiB) for optimizing the reading of big files;
+     * the buffer is taken from the BufferPool, and its size depends on the file's size (small files get small
+     * buffers).
+     * Note: the buffer must be set before opening the file, otherwise some implementations (e.g., libstdc++)
+     * ignore it. */
+    std::error_code error;
+    const auto fileSize = fs::file_size( filePath, error );
+    mBuffer = BufferPool::acquire( BufferPool::bufferSizeFor( error ? BufferPool::kMaxBufferSize : fileSize ) );
+    mFileStream.rdbuf()->pubsetbuf( reinterpret_cast< char* >( mBuffer.data() ), // NOLINT(*-reinterpret-cast)
+                                    static_cast< std::streamsize >( mBuffer.size() ) );
+    openFile( filePath );
 }
 
 void CFileInStream::openFile( const fs::path& filePath ) {
@@ -10,9 +10,8 @@
 #ifndef CFILEINSTREAM_HPP
 #define CFILEINSTREAM_HPP
 
-#include <array>
-
 #include "bitdefines.hpp"
+#include "internal/bufferpool.hpp"
 #include "internal/cstdinstream.hpp"
 #include "internal/fs.hpp"
 
@@ -25,9 +24,9 @@ class CFileInStream : public CStdInStream {
         void openFile( const fs::path& filePath );
 
     private:
+        // Note: the buffer must outlive the file stream using it, so it is declared (and constructed) first.
+        PooledBuffer mBuffer;
         fs::ifstream mFileStream;
-        static constexpr auto kBufferSize = 1024 * 1024; // 1 MiB
-        std::array< char, kBufferSize > mBuffer;
 };
 
 }  // namespace bit7z
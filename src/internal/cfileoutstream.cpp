@@ -18,17 +18,31 @@
 
 namespace bit7z {
 
-CFileOutStream::CFileOutStream( fs::path filePath, bool createAlways )
-    : CStdOutStream( mFileStream ), mFilePath{ std::move( filePath ) }, mBuffer{} {
+CFileOutStream::CFileOutStream( fs::path filePath, bool createAlways, uint64_t sizeHint )
+    : CFileOutStream( std::move( filePath ),
+                      createAlways ? FileOpenMode::CreateAlways : FileOpenMode::CreateNew,
+                      sizeHint ) {}
+
+CFileOutStream::CFileOutStream( fs::path filePath, FileOpenMode openMode, uint64_t sizeHint )
+    : CStdOutStream( mFileStream ),
+      mFilePath{ std::move( filePath ) },
+      mBuffer{ BufferPool::acquire( BufferPool::bufferSizeFor( sizeHint ) ) } {
     std::error_code error;
-    if ( !createAlways && fs::exists( mFilePath, error ) ) {
+    if ( openMode == FileOpenMode::CreateNew && fs::exists( mFilePath, error ) ) {
         if ( !error ) {
             // The call to fs::exists succeeded, but the filePath exists, and this is an error.
             error = std::make_error_code( std::errc::file_exists );
         }
         throw BitException( "Failed to create the output file", error, path_to_tstring( mFilePath ) );
     }
-    mFileStream.open( mFilePath, std::ios::binary | std::ios::trunc ); // flawfinder: ignore
+    // Note: the buffer must be set before opening the file, otherwise some implementations ignore it.
+    mFileStream.rdbuf()->pubsetbuf( reinterpret_cast< char* >( mBuffer.data() ), // NOLINT(*-reinterpret-cast)
+                                    static_cast< std::streamsize >( mBuffer.size() ) );
+    // Note: opening the file also for input makes the stream keep the existing content, without truncating it.
+    const auto openFlags = openMode == FileOpenMode::OpenExisting ?
+                           std::ios::binary | std::ios::in | std::ios::out :
+                           std::ios::binary | std::ios::trunc;
+    mFileStream.open( mFilePath, openFlags ); // flawfinder: ignore
     if ( mFileStream.fail() ) {
 #if defined( __MINGW32__ ) || defined( __MINGW64__ )
         error = std::error_code{ errno, std::generic_category() };
@@ -37,14 +51,39 @@ CFileOutStream::CFileOutStream( fs::path filePath, bool createAlways )
         throw BitException( "Failed to open the output file", last_error_code(), path_to_tstring( mFilePath ) );
 #endif
     }
-
-    mFileStream.rdbuf()->pubsetbuf( mBuffer.data(), kBufferSize );
 }
 
 auto CFileOutStream::fail() const -> bool {
     return mFileStream.fail();
 }
 
+auto CFileOutStream::flush() noexcept -> HRESULT {
+    mFileStream.flush();
+    return mFileStream.fail() ? E_FAIL : S_OK;
+}
+
+auto CFileOutStream::preallocate( uint64_t /*size*/ ) noexcept -> HRESULT {
+    return E_NOTIMPL; // The std::fstream API doesn't provide any way to preallocate the file.
+}
+
+// Note: the std::fstream API doesn't provide access to the native file handle,
+//       so the metadata of the file can only be set by path, after closing it.
+#ifdef _WIN32
+auto CFileOutStream::setFileTime( FILETIME /*creation*/,
+                                  FILETIME /*access*/,
+                                  FILETIME /*modified*/ ) noexcept -> HRESULT {
+    return E_NOTIMPL;
+}
+#else
+auto CFileOutStream::setModifiedTime( FILETIME /*modified*/ ) noexcept -> HRESULT {
+    return E_NOTIMPL;
+}
+
+auto CFileOutStream::setAttributes( DWORD /*attributes*/ ) noexcept -> HRESULT {
+    return E_NOTIMPL;
+}
+#endif
+
 COM_DECLSPEC_NOTHROW
 STDMETHODIMP CFileOutStream::SetSize( UInt64 newSize ) noexcept {
     std::error_code error;
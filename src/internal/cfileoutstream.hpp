@@ -10,30 +10,48 @@
 #ifndef CFILEOUTSTREAM_HPP
 #define CFILEOUTSTREAM_HPP
 
-#include <array>
-
 #include "bitdefines.hpp"
+#include "internal/bufferpool.hpp"
 #include "internal/cstdoutstream.hpp"
+#include "internal/filehandle.hpp"
 #include "internal/fs.hpp"
 
 namespace bit7z {
 
 class CFileOutStream : public CStdOutStream {
     public:
-        explicit CFileOutStream( fs::path filePath, bool createAlways = false );
+        explicit CFileOutStream( fs::path filePath,
+                                 bool createAlways = false,
+                                 uint64_t sizeHint = BufferPool::kMaxBufferSize );
+
+        CFileOutStream( fs::path filePath,
+                        FileOpenMode openMode,
+                        uint64_t sizeHint = BufferPool::kMaxBufferSize );
 
         BIT7Z_NODISCARD auto path() const -> const fs::path&;
 
         BIT7Z_NODISCARD auto fail() const -> bool;
 
+        auto flush() noexcept -> HRESULT;
+
+        auto preallocate( uint64_t size ) noexcept -> HRESULT;
+
+#ifdef _WIN32
+        auto setFileTime( FILETIME creation, FILETIME access, FILETIME modified ) noexcept -> HRESULT;
+#else
+        auto setModifiedTime( FILETIME modified ) noexcept -> HRESULT;
+
+        auto setAttributes( DWORD attributes ) noexcept -> HRESULT;
+#endif
+
         BIT7Z_STDMETHOD( SetSize, UInt64 newSize );
 
     private:
         fs::path mFilePath;
-        fs::ofstream mFileStream;
 
-        static constexpr auto kBufferSize = 1024 * 1024; // 1 MiB
-        std::array< char, kBufferSize > mBuffer;
+        // Note: the buffer must outlive the file stream using it, so it is declared (and constructed) first.
+        PooledBuffer mBuffer;
+        fs::ofstream mFileStream;
 };
 
 }  // namespace bit7z
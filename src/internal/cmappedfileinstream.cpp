@@ -0,0 +1,231 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "bitexception.hpp"
+#include "internal/cmappedfileinstream.hpp"
+#include "internal/stringutil.hpp"
+#include "internal/util.hpp"
+#include "internal/windows.hpp"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace bit7z {
+
+namespace {
+#ifdef _WIN32
+auto file_flags( AccessPatternHint hint ) noexcept -> DWORD {
+    switch ( hint ) {
+        case AccessPatternHint::Sequential:
+            return FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN;
+        case AccessPatternHint::Random:
+            return FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS;
+        case AccessPatternHint::Normal:
+        default:
+            return FILE_ATTRIBUTE_NORMAL;
+    }
+}
+
+auto map_file( const fs::path& filePath, AccessPatternHint hint, uint64_t& fileSize ) -> const byte_t* {
+    HANDLE fileHandle = ::CreateFileW( filePath.c_str(),
+                                       GENERIC_READ,
+                                       FILE_SHARE_READ,
+                                       nullptr,
+                                       OPEN_EXISTING,
+                                       file_flags( hint ),
+                                       nullptr );
+    if ( fileHandle == INVALID_HANDLE_VALUE ) {
+        throw BitException( "Failed to open the archive file", last_error_code(), path_to_tstring( filePath ) );
+    }
+
+    LARGE_INTEGER size{};
+    if ( ::GetFileSizeEx( fileHandle, &size ) == FALSE ) {
+        const auto error = last_error_code();
+        ::CloseHandle( fileHandle );
+        throw BitException( "Failed to get the size of the archive file", error, path_to_tstring( filePath ) );
+    }
+    fileSize = static_cast< uint64_t >( size.QuadPart );
+
+    if ( ::GetFileType( fileHandle ) != FILE_TYPE_DISK ) { // e.g., named pipes
+        ::CloseHandle( fileHandle );
+        throw BitException( "Failed to map the archive file in memory",
+                            std::make_error_code( std::errc::not_supported ),
+                            path_to_tstring( filePath ) );
+    }
+
+    if ( fileSize == 0 ) {
+        // Empty files cannot be mapped; the stream will simply read nothing.
+        ::CloseHandle( fileHandle );
+        return nullptr;
+    }
+
+    HANDLE mappingHandle = ::CreateFileMappingW( fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr );
+    const auto mappingError = last_error_code();
+    // The file mapping object keeps its own reference to the file, so we don't need the file handle anymore.
+    ::CloseHandle( fileHandle );
+    if ( mappingHandle == nullptr ) {
+        throw BitException( "Failed to map the archive file in memory", mappingError, path_to_tstring( filePath ) );
+    }
+
+    const void* view = ::MapViewOfFile( mappingHandle, FILE_MAP_READ, 0, 0, 0 );
+    const auto viewError = last_error_code();
+    // Similarly, the mapped view keeps a reference to the file mapping object.
+    ::CloseHandle( mappingHandle );
+    if ( view == nullptr ) {
+        throw BitException( "Failed to map the archive file in memory", viewError, path_to_tstring( filePath ) );
+    }
+    return static_cast< const byte_t* >( view );
+}
+
+void unmap_file( const byte_t* data, uint64_t /*size*/ ) noexcept {
+    ::UnmapViewOfFile( data );
+}
+#else
+auto map_advice( AccessPatternHint hint ) noexcept -> int {
+    switch ( hint ) {
+        case AccessPatternHint::Sequential:
+            return MADV_SEQUENTIAL;
+        case AccessPatternHint::Random:
+            return MADV_RANDOM;
+        case AccessPatternHint::Normal:
+        default:
+            return MADV_NORMAL;
+    }
+}
+
+auto map_file( const fs::path& filePath, AccessPatternHint hint, uint64_t& fileSize ) -> const byte_t* {
+    const int fileDescriptor = ::open( filePath.c_str(), O_RDONLY | O_CLOEXEC ); // flawfinder: ignore
+    if ( fileDescriptor < 0 ) {
+        throw BitException( "Failed to open the archive file", last_error_code(), path_to_tstring( filePath ) );
+    }
+
+    struct stat fileStat{};
+    if ( ::fstat( fileDescriptor, &fileStat ) != 0 ) {
+        const auto error = last_error_code();
+        ::close( fileDescriptor );
+        throw BitException( "Failed to get the size of the archive file", error, path_to_tstring( filePath ) );
+    }
+    fileSize = static_cast< uint64_t >( fileStat.st_size );
+
+    if ( !S_ISREG( fileStat.st_mode ) ) { // e.g., FIFOs and character devices, whose size is not meaningful.
+        ::close( fileDescriptor );
+        throw BitException( "Failed to map the archive file in memory",
+                            std::make_error_code( std::errc::not_supported ),
+                            path_to_tstring( filePath ) );
+    }
+
+    if ( fileSize == 0 ) {
+        // Empty files cannot be mapped; the stream will simply read nothing.
+        ::close( fileDescriptor );
+        return nullptr;
+    }
+
+    if ( fileSize > ( std::numeric_limits< std::size_t >::max )() ) {
+        ::close( fileDescriptor );
+        throw BitException( "Failed to map the archive file in memory",
+                            std::make_error_code( std::errc::file_too_large ),
+                            path_to_tstring( filePath ) );
+    }
+
+    const auto mapSize = static_cast< std::size_t >( fileSize );
+    void* mapping = ::mmap( nullptr, mapSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0 );
+    const auto mappingError = last_error_code();
+    // The mapping keeps its own reference to the file, so we can close the descriptor right away.
+    ::close( fileDescriptor );
+    if ( mapping == MAP_FAILED ) { // NOLINT(*-pro-type-cstyle-cast, *-int-to-ptr)
+        throw BitException( "Failed to map the archive file in memory", mappingError, path_to_tstring( filePath ) );
+    }
+
+    // The advice is just a hint for the kernel paging policy, so we can safely ignore any failure.
+    ::madvise( mapping, mapSize, map_advice( hint ) );
+    return static_cast< const byte_t* >( mapping );
+}
+
+void unmap_file( const byte_t* data, uint64_t size ) noexcept {
+    // NOLINTNEXTLINE(*-pro-type-const-cast)
+    ::munmap( const_cast< byte_t* >( data ), static_cast< std::size_t >( size ) );
+}
+#endif
+} // namespace
+
+CMappedFileInStream::CMappedFileInStream( const fs::path& filePath, AccessPatternHint hint )
+    : mData{ nullptr }, mSize{ 0 }, mCurrentPosition{ 0 } {
+    mData = map_file( filePath, hint, mSize );
+}
+
+CMappedFileInStream::~CMappedFileInStream() {
+    if ( mData != nullptr ) {
+        unmap_file( mData, mSize );
+    }
+}
+
+auto CMappedFileInStream::size() const noexcept -> uint64_t {
+    return mSize;
+}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CMappedFileInStream::Read( void* data, UInt32 size, UInt32* processedSize ) noexcept {
+    if ( processedSize != nullptr ) {
+        *processedSize = 0;
+    }
+
+    if ( size == 0 || mCurrentPosition >= mSize ) {
+        return S_OK;
+    }
+
+    // Note: the mapping size fits in a std::size_t, so does the current position (which is lower than the size).
+    const auto readSize = static_cast< UInt32 >( ( std::min )( mSize - mCurrentPosition,
+                                                               static_cast< uint64_t >( size ) ) );
+    std::memcpy( data, mData + static_cast< std::size_t >( mCurrentPosition ), readSize ); //-V2571
+    mCurrentPosition += readSize;
+
+    if ( processedSize != nullptr ) {
+        *processedSize = readSize;
+    }
+    return S_OK;
+}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CMappedFileInStream::Seek( Int64 offset, UInt32 seekOrigin, UInt64* newPosition ) noexcept {
+    uint64_t seekPosition{};
+    switch ( seekOrigin ) {
+        case STREAM_SEEK_SET:
+            break;
+        case STREAM_SEEK_CUR:
+            seekPosition = mCurrentPosition;
+            break;
+        case STREAM_SEEK_END:
+            seekPosition = mSize;
+            break;
+        default:
+            return STG_E_INVALIDFUNCTION;
+    }
+
+    // Note: like for file streams, seeking past the end is allowed, and subsequent reads will return no data.
+    RINOK( seek_to_offset( seekPosition, offset ) )
+    mCurrentPosition = seekPosition;
+
+    if ( newPosition != nullptr ) {
+        *newPosition = mCurrentPosition;
+    }
+    return S_OK;
+}
+
+} // namespace bit7z
@@ -0,0 +1,65 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CMAPPEDFILEINSTREAM_HPP
+#define CMAPPEDFILEINSTREAM_HPP
+
+#include "bitabstractarchivehandler.hpp"
+#include "bittypes.hpp"
+#include "internal/com.hpp"
+#include "internal/fs.hpp"
+#include "internal/guids.hpp"
+#include "internal/macros.hpp"
+
+#include <7zip/IStream.h>
+
+namespace bit7z {
+
+/**
+ * An input stream reading a file through a read-only memory mapping of its whole content.
+ *
+ * The constructor throws a BitException if the file is not a regular file or cannot be mapped
+ * (e.g., when it is larger than the address space).
+ *
+ * @note Read is noexcept, but if the file is truncated while mapped, accessing the pages past its new end
+ *       raises SIGBUS (POSIX) or EXCEPTION_IN_PAGE_ERROR (Windows): the mapped file must not be truncated.
+ */
+class CMappedFileInStream final : public IInStream, public CMyUnknownImp {
+    public:
+        explicit CMappedFileInStream( const fs::path& filePath, AccessPatternHint hint = AccessPatternHint::Normal );
+
+        CMappedFileInStream( const CMappedFileInStream& ) = delete;
+
+        CMappedFileInStream( CMappedFileInStream&& ) = delete;
+
+        auto operator=( const CMappedFileInStream& ) -> CMappedFileInStream& = delete;
+
+        auto operator=( CMappedFileInStream&& ) -> CMappedFileInStream& = delete;
+
+        MY_UNKNOWN_DESTRUCTOR( ~CMappedFileInStream() );
+
+        BIT7Z_NODISCARD auto size() const noexcept -> uint64_t;
+
+        // IInStream
+        BIT7Z_STDMETHOD( Read, void* data, UInt32 size, UInt32* processedSize );
+
+        BIT7Z_STDMETHOD( Seek, Int64 offset, UInt32 seekOrigin, UInt64* newPosition );
+
+        // NOLINTNEXTLINE(modernize-use-noexcept, modernize-use-trailing-return-type, readability-identifier-length)
+        MY_UNKNOWN_IMP1( IInStream )  //-V2507 //-V2511 //-V835
+
+    private:
+        const byte_t* mData;
+        uint64_t mSize;
+        uint64_t mCurrentPosition;
+};
+
+}  // namespace bit7z
+
+#endif // CMAPPEDFILEINSTREAM_HPP
@@ -14,51 +14,98 @@
 #define NOMINMAX
 #endif
 
+#include <algorithm>
+
 #include "internal/cmultivolumeinstream.hpp"
+#include "internal/stringutil.hpp"
 #include "internal/util.hpp"
-#include "internal/fsutil.hpp"
 
 namespace bit7z {
 
-CMultiVolumeInStream::CMultiVolumeInStream( const fs::path& firstVolume ) : mCurrentPosition{ 0 }, mTotalSize{ 0 } {
+namespace {
+// Maximum number of volume files kept open at the same time.
+constexpr std::size_t kMaxOpenVolumes = 8;
+
+auto volume_path( const fs::path& firstVolume, std::size_t volumeNumber ) -> fs::path {
     constexpr size_t kVolumeDigits = 3u;
-    size_t volumeIndex = 1u;
+    tstring volumeExt = to_tstring( volumeNumber );
+    if ( volumeExt.length() < kVolumeDigits ) {
+        volumeExt.insert( volumeExt.begin(), kVolumeDigits - volumeExt.length(), BIT7Z_STRING( '0' ) );
+    }
     fs::path volumePath = firstVolume;
-    while ( fs::exists( volumePath ) ) {
-        addVolume( volumePath );
+    volumePath.replace_extension( volumeExt );
+    return volumePath;
+}
+} // namespace
+
+CMultiVolumeInStream::CMultiVolumeInStream( const fs::path& firstVolume )
+    : mFirstVolumePath{ firstVolume },
+      mCurrentPosition{ 0 },
+      mTotalSize{ 0 },
+      mAllVolumesFound{ false },
+      mCurrentVolumeIndex{ 0 } {
+    /* Volumes are found lazily, as the stream is read; we only look for the first one here.
+     * Also, volume files are opened only when read, and at most kMaxOpenVolumes are kept open at the same time. */
+    findNextVolume();
+}
 
-        ++volumeIndex;
-        tstring volumeExt = to_tstring( volumeIndex );
-        if ( volumeExt.length() < kVolumeDigits ) {
-            volumeExt.insert( volumeExt.begin(), kVolumeDigits - volumeExt.length(), BIT7Z_STRING( '0' ) );
-        }
-        volumePath.replace_extension( volumeExt );
-
-        // TODO: Avoid keeping all the volumes streams open
-        constexpr auto kOpenedFilesThreshold = 500;
-        if ( volumeIndex == kOpenedFilesThreshold ) {
-            // Note: we use == to avoid increasing the limit more than once;
-            // the volumeIndex is always increasing, so it is not an issue here.
-            filesystem::fsutil::increase_opened_files_limit();
-        }
+auto CMultiVolumeInStream::findNextVolume() -> bool {
+    if ( mAllVolumesFound ) {
+        return false;
     }
+
+    const fs::path volumePath = volume_path( mFirstVolumePath, mVolumes.size() + 1 );
+    std::error_code error;
+    if ( !fs::exists( volumePath, error ) ) {
+        mAllVolumesFound = true;
+        return false;
+    }
+
+    mVolumes.emplace_back( make_com< CVolumeInStream >( volumePath, mTotalSize ) );
+    mTotalSize += mVolumes.back()->size();
+    return true;
+}
+
+void CMultiVolumeInStream::findAllVolumes() {
+    while ( findNextVolume() ) {}
 }
 
 auto CMultiVolumeInStream::currentVolume() -> const CMyComPtr< CVolumeInStream >& {
-    size_t left = 0;
-    size_t right = mVolumes.size();
-    size_t midpoint = right / 2;
-    while ( true ) {
-        auto& volume = mVolumes[ midpoint ];
-        if ( mCurrentPosition < volume->globalOffset() ) {
-            right = midpoint;
-        } else if ( mCurrentPosition >= volume->globalOffset() + volume->size() ) {
-            left = midpoint + 1;
-        } else {
-            return volume;
-        }
-        midpoint = ( left + right ) / 2;
+    // Fast path: usually, the stream is read sequentially, so the position is in the current or in the next volume.
+    const auto isInVolume = [ this ]( std::size_t volumeIndex ) -> bool {
+        const auto& volume = mVolumes[ volumeIndex ];
+        return mCurrentPosition >= volume->globalOffset() &&
+               mCurrentPosition < volume->globalOffset() + volume->size();
+    };
+    if ( isInVolume( mCurrentVolumeIndex ) ) {
+        return mVolumes[ mCurrentVolumeIndex ];
+    }
+    if ( mCurrentVolumeIndex + 1 < mVolumes.size() && isInVolume( mCurrentVolumeIndex + 1 ) ) {
+        return mVolumes[ ++mCurrentVolumeIndex ];
     }
+
+    // Note: the volumes are sorted by their global offset, and the position is before the end of the last volume.
+    const auto volumeIt = std::upper_bound( mVolumes.cbegin(), mVolumes.cend(), mCurrentPosition,
+                                            []( uint64_t position, const CMyComPtr< CVolumeInStream >& volume ) {
+                                                return position < volume->globalOffset();
+                                            } );
+    mCurrentVolumeIndex = static_cast< std::size_t >( std::distance( mVolumes.cbegin(), volumeIt ) ) - 1;
+    return mVolumes[ mCurrentVolumeIndex ];
+}
+
+void CMultiVolumeInStream::markAsUsed( std::size_t volumeIndex ) {
+    if ( !mOpenVolumes.empty() && mOpenVolumes.back() == volumeIndex ) {
+        return; // Fast path: the volume is already the most recently used.
+    }
+
+    const auto openIt = std::find( mOpenVolumes.begin(), mOpenVolumes.end(), volumeIndex );
+    if ( openIt != mOpenVolumes.end() ) {
+        mOpenVolumes.erase( openIt );
+    } else if ( mOpenVolumes.size() == kMaxOpenVolumes ) {
+        mVolumes[ mOpenVolumes.front() ]->close();
+        mOpenVolumes.erase( mOpenVolumes.begin() );
+    }
+    mOpenVolumes.push_back( volumeIndex );
 }
 
 COM_DECLSPEC_NOTHROW
@@ -67,22 +114,30 @@ STDMETHODIMP CMultiVolumeInStream::Read( void* data, UInt32 size, UInt32* proces
         *processedSize = 0;
     }
 
-    if ( size == 0 || mCurrentPosition >= mTotalSize ) {
+    if ( size == 0 ) {
         return S_OK;
     }
 
-    const auto& volume = currentVolume();
-    UInt64 localOffset = mCurrentPosition - volume->globalOffset();
-    HRESULT result = volume->Seek( static_cast< Int64 >( localOffset ), STREAM_SEEK_SET, &localOffset );
-    if ( result != S_OK ) {
-        return result;
+    try {
+        while ( mCurrentPosition >= mTotalSize ) {
+            if ( !findNextVolume() ) {
+                return S_OK;
+            }
+        }
+    } catch ( const std::exception& ) {
+        return E_FAIL;
     }
 
+    const auto& volume = currentVolume();
+    const UInt64 localOffset = mCurrentPosition - volume->globalOffset();
+    RINOK( volume->Seek( static_cast< Int64 >( localOffset ), STREAM_SEEK_SET, nullptr ) )
+
     const uint64_t remaining = volume->size() - localOffset;
     if ( size > remaining ) {
         size = static_cast< UInt32 >( remaining );
     }
-    result = volume->Read( data, size, &size );
+    markAsUsed( mCurrentVolumeIndex );
+    const HRESULT result = volume->Read( data, size, &size );
     mCurrentPosition += size;
 
     if ( processedSize != nullptr ) {
@@ -101,6 +156,11 @@ STDMETHODIMP CMultiVolumeInStream::Seek( Int64 offset, UInt32 seekOrigin, UInt64
             seekPosition = mCurrentPosition;
             break;
         case STREAM_SEEK_END:
+            try {
+                findAllVolumes();
+            } catch ( const std::exception& ) {
+                return E_FAIL;
+            }
             seekPosition = mTotalSize;
             break;
         default:
@@ -116,14 +176,4 @@ STDMETHODIMP CMultiVolumeInStream::Seek( Int64 offset, UInt32 seekOrigin, UInt64
     return S_OK;
 }
 
-void CMultiVolumeInStream::addVolume( const fs::path& volumePath ) {
-    uint64_t globalOffset = 0;
-    if ( !mVolumes.empty() ) {
-        const auto& lastStream = mVolumes.back();
-        globalOffset = lastStream->globalOffset() + lastStream->size();
-    }
-    mVolumes.emplace_back( make_com< CVolumeInStream >( volumePath, globalOffset ) );
-    mTotalSize += mVolumes.back()->size();
-}
-
-} // namespace bit7z
\ No newline at end of file
+} // namespace bit7z
@@ -15,19 +15,31 @@
 #include "internal/macros.hpp"
 #include "internal/guiddef.hpp"
 
+#include <vector>
+
 #include <7zip/IStream.h>
 
 namespace bit7z {
 
 class CMultiVolumeInStream : public IInStream, public CMyUnknownImp {
+        fs::path mFirstVolumePath;
         uint64_t mCurrentPosition;
         uint64_t mTotalSize;
+        bool mAllVolumesFound;
 
         std::vector< CMyComPtr< CVolumeInStream > > mVolumes;
+        std::size_t mCurrentVolumeIndex;
+
+        // Indices of the volumes whose files are currently open, from the least to the most recently used.
+        std::vector< std::size_t > mOpenVolumes;
 
         auto currentVolume() -> const CMyComPtr< CVolumeInStream >&;
 
-        void addVolume( const fs::path& volumePath );
+        auto findNextVolume() -> bool;
+
+        void findAllVolumes();
+
+        void markAsUsed( std::size_t volumeIndex );
 
     public:
         explicit CMultiVolumeInStream( const fs::path& firstVolume );
@@ -14,7 +14,6 @@
 
 #include "bitexception.hpp"
 #include "internal/cmultivolumeoutstream.hpp"
-#include "internal/fsutil.hpp"
 #include "internal/util.hpp"
 
 namespace bit7z {
@@ -23,6 +22,7 @@ CMultiVolumeOutStream::CMultiVolumeOutStream( uint64_t volSize, fs::path archive
     : mMaxVolumeSize( volSize ),
       mVolumePrefix( std::move( archiveName ) ),
       mCurrentVolumeIndex( 0 ),
+      mLastVolumeIndex( 0 ),
       mCurrentVolumeOffset( 0 ),
       mAbsoluteOffset( 0 ),
       mFullSize( 0 ) {}
@@ -46,18 +46,22 @@ STDMETHODIMP CMultiVolumeOutStream::Write( const void* data, UInt32 size, UInt32
         fs::path volumePath = mVolumePrefix;
         volumePath += BIT7Z_STRING( "." ) + name;
         try {
-            // TODO: Avoid keeping all the volumes streams open
-            constexpr auto kOpenedFilesThreshold = 500;
-            if ( mCurrentVolumeIndex == kOpenedFilesThreshold ) {
-                // Since we have created many volumes, it is likely we'll keep creating more.
-                // Hence, we increase the limit to the number of files that can be opened by the current process
-                // to avoid problems in the future.
-                filesystem::fsutil::increase_opened_files_limit();
-            }
             mVolumes.emplace_back( make_com< CVolumeOutStream >( volumePath ) );
         } catch ( const BitException& ex ) {
             return ex.nativeCode();
         }
+        if ( mVolumes.size() - 1 != mCurrentVolumeIndex ) {
+            /* Intermediate volume we are skipping over: no need to keep it open. */
+            RINOK( mVolumes.back()->close() )
+        }
+    }
+
+    if ( mLastVolumeIndex != mCurrentVolumeIndex ) {
+        /* We moved to another volume: the one we wrote to last can be closed (it will be reopened if needed). */
+        if ( mLastVolumeIndex < mVolumes.size() ) {
+            RINOK( mVolumes[ mLastVolumeIndex ]->close() )
+        }
+        mLastVolumeIndex = mCurrentVolumeIndex;
     }
 
     /* Getting the current volume stream. */
@@ -94,7 +98,8 @@ STDMETHODIMP CMultiVolumeOutStream::Write( const void* data, UInt32 size, UInt32
     }
 
     if ( volume->currentOffset() == mMaxVolumeSize ) {
-        /* We reached the max size for the current volume, so we need to continue on the next one. */
+        /* We reached the max size for the current volume, so we can close it and continue on the next one. */
+        RINOK( volume->close() )
         ++mCurrentVolumeIndex;
         mCurrentVolumeOffset = 0;
     }
@@ -147,6 +152,7 @@ STDMETHODIMP CMultiVolumeOutStream::SetSize( UInt64 newSize ) noexcept {
     }
     mCurrentVolumeOffset = mAbsoluteOffset;
     mCurrentVolumeIndex = 0;
+    mLastVolumeIndex = 0;
     mFullSize = newSize;
     return S_OK;
 }
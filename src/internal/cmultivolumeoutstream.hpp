@@ -36,6 +36,9 @@ class CMultiVolumeOutStream final : public IOutStream, public CMyUnknownImp {
         // The current volume stream on which we are working.
         size_t mCurrentVolumeIndex;
 
+        // The volume stream we wrote to last; it is the only one kept open while writing.
+        size_t mLastVolumeIndex;
+
         // Offset from the beginning of the current volume stream (i.e., the one at mCurrentVolumeIndex).
         uint64_t mCurrentVolumeOffset;
 
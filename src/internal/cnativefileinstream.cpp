@@ -0,0 +1,115 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#include "bitexception.hpp"
+#include "internal/cnativefileinstream.hpp"
+#include "internal/stringutil.hpp"
+#include "internal/util.hpp"
+
+namespace bit7z {
+
+// Reads smaller than this size are served from the read buffer, larger ones go directly to the file.
+constexpr UInt32 kReadBufferSize = 64 * 1024;
+
+CNativeFileInStream::CNativeFileInStream( const fs::path& filePath )
+    : mFile{ filePath, FileOpenMode::Read },
+      mFileSize{ 0 },
+      mCurrentPosition{ 0 },
+      mBufferOffset{ 0 },
+      mBufferedSize{ 0 } {
+    // Input files are not expected to change while being read, so we query their size only once.
+    const HRESULT res = mFile.size( mFileSize );
+    if ( res != S_OK ) {
+        throw BitException( "Failed to get the size of the file",
+                            make_hresult_code( res ),
+                            path_to_tstring( filePath ) );
+    }
+}
+
+auto CNativeFileInStream::fileSize() const noexcept -> uint64_t {
+    return mFileSize;
+}
+
+auto CNativeFileInStream::readBuffered( void* data, UInt32 size, UInt32& processedSize ) noexcept -> HRESULT {
+    const bool isBuffered = mCurrentPosition >= mBufferOffset && mCurrentPosition < mBufferOffset + mBufferedSize;
+    if ( !isBuffered ) {
+        if ( !mReadBuffer ) {
+            mReadBuffer.reset( new( std::nothrow ) byte_t[ kReadBufferSize ] ); // NOLINT(*-avoid-c-arrays)
+            if ( !mReadBuffer ) { // Not enough memory for the buffer, so we simply read directly from the file.
+                return mFile.read( data, size, mCurrentPosition, processedSize );
+            }
+        }
+        mBufferedSize = 0;
+        RINOK( mFile.read( mReadBuffer.get(), kReadBufferSize, mCurrentPosition, mBufferedSize ) )
+        mBufferOffset = mCurrentPosition;
+    }
+
+    const auto bufferPosition = static_cast< UInt32 >( mCurrentPosition - mBufferOffset );
+    processedSize = ( std::min )( size, mBufferedSize - bufferPosition );
+    std::memcpy( data, mReadBuffer.get() + bufferPosition, processedSize );
+    return S_OK;
+}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CNativeFileInStream::Read( void* data, UInt32 size, UInt32* processedSize ) noexcept {
+    if ( processedSize != nullptr ) {
+        *processedSize = 0;
+    }
+
+    if ( size == 0 || mCurrentPosition >= mFileSize ) {
+        return S_OK;
+    }
+
+    UInt32 readSize = 0;
+    if ( size < kReadBufferSize ) {
+        RINOK( readBuffered( data, size, readSize ) )
+    } else {
+        RINOK( mFile.read( data, size, mCurrentPosition, readSize ) )
+    }
+    mCurrentPosition += readSize;
+
+    if ( processedSize != nullptr ) {
+        *processedSize = readSize;
+    }
+    return S_OK;
+}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CNativeFileInStream::Seek( Int64 offset, UInt32 seekOrigin, UInt64* newPosition ) noexcept {
+    uint64_t seekPosition{};
+    switch ( seekOrigin ) {
+        case STREAM_SEEK_SET:
+            break;
+        case STREAM_SEEK_CUR:
+            seekPosition = mCurrentPosition;
+            break;
+        case STREAM_SEEK_END:
+            seekPosition = mFileSize;
+            break;
+        default:
+            return STG_E_INVALIDFUNCTION;
+    }
+
+    RINOK( seek_to_offset( seekPosition, offset ) )
+    mCurrentPosition = seekPosition;
+
+    if ( newPosition != nullptr ) {
+        *newPosition = mCurrentPosition;
+    }
+    return S_OK;
+}
+
+} // namespace bit7z
@@ -0,0 +1,70 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CNATIVEFILEINSTREAM_HPP
+#define CNATIVEFILEINSTREAM_HPP
+
+#include "bitdefines.hpp"
+#include "internal/com.hpp"
+#include "internal/filehandle.hpp"
+#include "internal/fs.hpp"
+#include "internal/guids.hpp"
+#include "internal/macros.hpp"
+
+#include <memory>
+
+#include <7zip/IStream.h>
+
+namespace bit7z {
+
+/**
+ * An input file stream reading directly from a native file handle via positional reads,
+ * and keeping track of the current offset by itself (i.e., seeking never involves the OS).
+ *
+ * Small reads (e.g., of archive headers) are served from a small read-combining buffer,
+ * while large reads go directly to the file.
+ */
+class CNativeFileInStream : public IInStream, public CMyUnknownImp {
+    public:
+        explicit CNativeFileInStream( const fs::path& filePath );
+
+        CNativeFileInStream( const CNativeFileInStream& ) = delete;
+
+        CNativeFileInStream( CNativeFileInStream&& ) = delete;
+
+        auto operator=( const CNativeFileInStream& ) -> CNativeFileInStream& = delete;
+
+        auto operator=( CNativeFileInStream&& ) -> CNativeFileInStream& = delete;
+
+        MY_UNKNOWN_VIRTUAL_DESTRUCTOR( ~CNativeFileInStream() ) = default;
+
+        BIT7Z_NODISCARD auto fileSize() const noexcept -> uint64_t;
+
+        // IInStream
+        BIT7Z_STDMETHOD( Read, void* data, UInt32 size, UInt32* processedSize );
+
+        BIT7Z_STDMETHOD( Seek, Int64 offset, UInt32 seekOrigin, UInt64* newPosition );
+
+        // NOLINTNEXTLINE(modernize-use-noexcept, modernize-use-trailing-return-type, readability-identifier-length)
+        MY_UNKNOWN_IMP1( IInStream ) //-V2507 //-V2511 //-V835
+
+    private:
+        FileHandle mFile;
+        uint64_t mFileSize;
+        uint64_t mCurrentPosition;
+        std::unique_ptr< byte_t[] > mReadBuffer; // NOLINT(*-avoid-c-arrays)
+        uint64_t mBufferOffset; // The offset in the file of the first byte of the read buffer.
+        UInt32 mBufferedSize;
+
+        auto readBuffered( void* data, UInt32 size, UInt32& processedSize ) noexcept -> HRESULT;
+};
+
+}  // namespace bit7z
+
+#endif // CNATIVEFILEINSTREAM_HPP
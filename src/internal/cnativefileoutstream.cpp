@@ -0,0 +1,191 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <cstring>
+#include <new>
+#include <utility>
+
+#include "internal/cnativefileoutstream.hpp"
+#include "internal/fsutil.hpp"
+#include "internal/util.hpp"
+
+namespace bit7z {
+
+// Writes smaller than this size are combined in the write buffer, larger ones go directly to the file.
+constexpr UInt32 kWriteBufferSize = 64 * 1024;
+
+CNativeFileOutStream::CNativeFileOutStream( fs::path filePath, bool createAlways )
+    : CNativeFileOutStream( std::move( filePath ), createAlways, false ) {}
+
+CNativeFileOutStream::CNativeFileOutStream( fs::path filePath, FileOpenMode openMode )
+    : mFilePath{ std::move( filePath ) },
+      mFile{ mFilePath, openMode },
+      mCurrentPosition{ 0 },
+      mFailed{ false },
+      mBufferOffset{ 0 },
+      mBufferedSize{ 0 } {}
+
+CNativeFileOutStream::CNativeFileOutStream( fs::path filePath, bool createAlways, bool unbuffered )
+    : mFilePath{ std::move( filePath ) },
+      mFile{ mFilePath, createAlways ? FileOpenMode::CreateAlways : FileOpenMode::CreateNew, unbuffered },
+      mCurrentPosition{ 0 },
+      mFailed{ false },
+      mBufferOffset{ 0 },
+      mBufferedSize{ 0 } {}
+
+CNativeFileOutStream::~CNativeFileOutStream() {
+    // Note: errors cannot be reported here; users that need them must call flush() before releasing the stream.
+    static_cast< void >( flushBuffer() );
+}
+
+auto CNativeFileOutStream::path() const -> const fs::path& {
+    return mFilePath;
+}
+
+auto CNativeFileOutStream::fail() const -> bool {
+    return mFailed;
+}
+
+auto CNativeFileOutStream::flush() noexcept -> HRESULT {
+    return flushBuffer();
+}
+
+auto CNativeFileOutStream::flushBuffer() noexcept -> HRESULT {
+    UInt32 writtenSize = 0;
+    while ( writtenSize < mBufferedSize ) {
+        UInt32 processedSize = 0;
+        const HRESULT res = mFile.write( mWriteBuffer.get() + writtenSize,
+                                         mBufferedSize - writtenSize,
+                                         mBufferOffset + writtenSize,
+                                         processedSize );
+        if ( res != S_OK || processedSize == 0 ) {
+            mFailed = true;
+            return res != S_OK ? res : E_FAIL;
+        }
+        writtenSize += processedSize;
+    }
+    mBufferedSize = 0;
+    return S_OK;
+}
+
+auto CNativeFileOutStream::preallocate( uint64_t size ) noexcept -> HRESULT {
+    return mFile.preallocate( size );
+}
+
+#ifdef _WIN32
+auto CNativeFileOutStream::setFileTime( FILETIME creation,
+                                        FILETIME access,
+                                        FILETIME modified ) noexcept -> HRESULT {
+    RINOK( flushBuffer() ) // Otherwise, writing the buffered data would change the last modified time.
+    return filesystem::fsutil::set_file_time( mFile.native(), creation, access, modified ) ? S_OK : E_FAIL;
+}
+#else
+auto CNativeFileOutStream::setModifiedTime( FILETIME modified ) noexcept -> HRESULT {
+    RINOK( flushBuffer() ) // Otherwise, writing the buffered data would change the last modified time.
+    return filesystem::fsutil::set_file_modified_time( mFile.native(), modified ) ? S_OK : E_FAIL;
+}
+
+auto CNativeFileOutStream::setAttributes( DWORD attributes ) noexcept -> HRESULT {
+    RINOK( flushBuffer() ) // The attributes might make the file read-only.
+    return filesystem::fsutil::set_file_attributes( mFile.native(), attributes ) ? S_OK : E_FAIL;
+}
+#endif
+
+auto CNativeFileOutStream::file() noexcept -> FileHandle& {
+    return mFile;
+}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CNativeFileOutStream::Write( const void* data, UInt32 size, UInt32* processedSize ) noexcept {
+    if ( processedSize != nullptr ) {
+        *processedSize = 0;
+    }
+
+    if ( size == 0 ) {
+        return S_OK;
+    }
+
+    if ( size < kWriteBufferSize ) {
+        if ( !mWriteBuffer ) {
+            mWriteBuffer.reset( new( std::nothrow ) byte_t[ kWriteBufferSize ] ); // NOLINT(*-avoid-c-arrays)
+        }
+        if ( mWriteBuffer ) {
+            if ( size > kWriteBufferSize - mBufferedSize ) {
+                RINOK( flushBuffer() )
+            }
+            if ( mBufferedSize == 0 ) {
+                mBufferOffset = mCurrentPosition;
+            }
+            std::memcpy( mWriteBuffer.get() + mBufferedSize, data, size );
+            mBufferedSize += size;
+            mCurrentPosition += size;
+
+            if ( processedSize != nullptr ) {
+                *processedSize = size;
+            }
+            return S_OK;
+        }
+        // Not enough memory for the buffer, so we simply write directly to the file.
+    }
+
+    RINOK( flushBuffer() )
+    UInt32 writtenSize = 0;
+    const HRESULT res = mFile.write( data, size, mCurrentPosition, writtenSize );
+    if ( res != S_OK ) {
+        mFailed = true;
+        return res;
+    }
+    mCurrentPosition += writtenSize;
+
+    if ( processedSize != nullptr ) {
+        *processedSize = writtenSize;
+    }
+    return S_OK;
+}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CNativeFileOutStream::Seek( Int64 offset, UInt32 seekOrigin, UInt64* newPosition ) noexcept {
+    uint64_t seekPosition{};
+    switch ( seekOrigin ) {
+        case STREAM_SEEK_SET:
+            break;
+        case STREAM_SEEK_CUR:
+            seekPosition = mCurrentPosition;
+            break;
+        case STREAM_SEEK_END:
+            RINOK( flushBuffer() ) // The buffered data might extend the file.
+            RINOK( mFile.size( seekPosition ) )
+            break;
+        default:
+            return STG_E_INVALIDFUNCTION;
+    }
+
+    RINOK( seek_to_offset( seekPosition, offset ) )
+    if ( seekPosition != mCurrentPosition ) {
+        // The buffered data must be contiguous to the current position.
+        RINOK( flushBuffer() )
+    }
+    mCurrentPosition = seekPosition;
+
+    if ( newPosition != nullptr ) {
+        *newPosition = mCurrentPosition;
+    }
+    return S_OK;
+}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CNativeFileOutStream::SetSize( UInt64 newSize ) noexcept {
+    RINOK( flushBuffer() )
+    return mFile.resize( newSize );
+}
+
+} // namespace bit7z
@@ -0,0 +1,98 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CNATIVEFILEOUTSTREAM_HPP
+#define CNATIVEFILEOUTSTREAM_HPP
+
+#include "bitdefines.hpp"
+#include "internal/com.hpp"
+#include "internal/filehandle.hpp"
+#include "internal/fs.hpp"
+#include "internal/guids.hpp"
+#include "internal/macros.hpp"
+
+#include <memory>
+
+#include <7zip/IStream.h>
+
+namespace bit7z {
+
+/**
+ * An output file stream writing directly to a native file handle via positional writes,
+ * and keeping track of the current offset by itself (i.e., seeking never involves the OS).
+ *
+ * Small sequential writes are combined in a small write buffer, while large writes go directly to the file.
+ */
+class CNativeFileOutStream : public IOutStream, public CMyUnknownImp {
+    public:
+        explicit CNativeFileOutStream( fs::path filePath, bool createAlways = false );
+
+        CNativeFileOutStream( fs::path filePath, FileOpenMode openMode );
+
+        CNativeFileOutStream( const CNativeFileOutStream& ) = delete;
+
+        CNativeFileOutStream( CNativeFileOutStream&& ) = delete;
+
+        auto operator=( const CNativeFileOutStream& ) -> CNativeFileOutStream& = delete;
+
+        auto operator=( CNativeFileOutStream&& ) -> CNativeFileOutStream& = delete;
+
+        MY_UNKNOWN_VIRTUAL_DESTRUCTOR( ~CNativeFileOutStream() );
+
+        BIT7Z_NODISCARD auto path() const -> const fs::path&;
+
+        BIT7Z_NODISCARD auto fail() const -> bool;
+
+        // Writes to the file any data still buffered by the stream.
+        virtual auto flush() noexcept -> HRESULT;
+
+        // Reserves the disk space for a file of the given size (it is only a hint, the file size doesn't change).
+        auto preallocate( uint64_t size ) noexcept -> HRESULT;
+
+#ifdef _WIN32
+        // Sets the times of the still open file (empty FILETIME objects leave the corresponding times unchanged).
+        auto setFileTime( FILETIME creation, FILETIME access, FILETIME modified ) noexcept -> HRESULT;
+#else
+        // Sets the last modified time of the still open file.
+        auto setModifiedTime( FILETIME modified ) noexcept -> HRESULT;
+
+        // Sets the attributes of the still open file (it fails for items that must be restored by path).
+        auto setAttributes( DWORD attributes ) noexcept -> HRESULT;
+#endif
+
+        // IOutStream
+        BIT7Z_STDMETHOD( Write, const void* data, UInt32 size, UInt32* processedSize );
+
+        BIT7Z_STDMETHOD( Seek, Int64 offset, UInt32 seekOrigin, UInt64* newPosition );
+
+        BIT7Z_STDMETHOD( SetSize, UInt64 newSize );
+
+        // NOLINTNEXTLINE(modernize-use-noexcept, modernize-use-trailing-return-type, readability-identifier-length)
+        MY_UNKNOWN_IMP1( IOutStream ) //-V2507 //-V2511 //-V835
+
+    protected:
+        CNativeFileOutStream( fs::path filePath, bool createAlways, bool unbuffered );
+
+        BIT7Z_NODISCARD auto file() noexcept -> FileHandle&;
+
+    private:
+        fs::path mFilePath;
+        FileHandle mFile;
+        uint64_t mCurrentPosition;
+        bool mFailed;
+        std::unique_ptr< byte_t[] > mWriteBuffer; // NOLINT(*-avoid-c-arrays)
+        uint64_t mBufferOffset; // The offset in the file of the first byte of the write buffer.
+        UInt32 mBufferedSize;
+
+        auto flushBuffer() noexcept -> HRESULT;
+};
+
+}  // namespace bit7z
+
+#endif // CNATIVEFILEOUTSTREAM_HPP
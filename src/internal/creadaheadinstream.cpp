@@ -0,0 +1,225 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <system_error>
+#include <utility>
+
+#include "internal/creadaheadinstream.hpp"
+#include "internal/util.hpp"
+
+namespace bit7z {
+
+auto CReadAheadInStream::Window::contains( uint64_t position ) const noexcept -> bool {
+    return position >= offset && position < end();
+}
+
+auto CReadAheadInStream::Window::end() const noexcept -> uint64_t {
+    return offset + size;
+}
+
+// Note: unlike buffer_t and std::make_unique, this doesn't zero-fill the (possibly large) window buffer.
+inline auto make_window_buffer( std::size_t windowSize ) -> std::unique_ptr< byte_t[] > { // NOLINT(*-avoid-c-arrays)
+    return std::unique_ptr< byte_t[] >( new byte_t[ windowSize ] ); // NOLINT(*-avoid-c-arrays, *-owning-memory)
+}
+
+CReadAheadInStream::CReadAheadInStream( CMyComPtr< IInStream > inStream, std::size_t windowSize )
+    : mInStream{ std::move( inStream ) },
+      mInStreamPosition{ 0 },
+      mCurrentPosition{ 0 },
+      mCurrentWindow{ make_window_buffer( windowSize ), windowSize, 0, 0 },
+      mNextWindow{ make_window_buffer( windowSize ), windowSize, 0, 0 },
+      mReadAheadPending{ false },
+      mReadInProgress{ false },
+      mStopping{ false },
+      mReadAheadOffset{ 0 },
+      mReadAheadResult{ S_OK } {
+    // The wrapped stream might not be at its beginning, so we start reading from its current position.
+    if ( mInStream->Seek( 0, STREAM_SEEK_CUR, &mInStreamPosition ) == S_OK ) {
+        mCurrentPosition = mInStreamPosition;
+        mCurrentWindow.offset = mInStreamPosition;
+    }
+}
+
+CReadAheadInStream::~CReadAheadInStream() {
+    if ( !mReadAheadThread.joinable() ) {
+        return;
+    }
+    {
+        const std::lock_guard< std::mutex > lock{ mMutex };
+        mStopping = true;
+    }
+    mReadPosted.notify_one();
+    // The helper thread uses this object, so we must wait for it to finish (including any read in progress).
+    mReadAheadThread.join();
+}
+
+auto CReadAheadInStream::fillWindow( Window& window, uint64_t offset ) noexcept -> HRESULT {
+    window.offset = offset;
+    window.size = 0;
+    if ( mInStreamPosition != offset ) {
+        RINOK( mInStream->Seek( static_cast< Int64 >( offset ), STREAM_SEEK_SET, &mInStreamPosition ) )
+    }
+
+    while ( window.size < window.capacity ) {
+        const auto readSize = clamp_cast< UInt32 >( window.capacity - window.size );
+        UInt32 processedSize = 0;
+        const HRESULT res = mInStream->Read( window.buffer.get() + window.size, readSize, &processedSize );
+        mInStreamPosition += processedSize;
+        window.size += processedSize;
+        if ( res != S_OK ) {
+            return res;
+        }
+        if ( processedSize == 0 ) { // End of the wrapped stream.
+            break;
+        }
+    }
+    return S_OK;
+}
+
+void CReadAheadInStream::runReadAhead() noexcept {
+    std::unique_lock< std::mutex > lock{ mMutex };
+    while ( true ) {
+        mReadPosted.wait( lock, [ this ]() -> bool {
+            return mStopping || mReadInProgress;
+        } );
+        if ( mStopping ) {
+            return;
+        }
+
+        const uint64_t offset = mReadAheadOffset;
+        lock.unlock();
+        // Note: while a read is in progress, the reader accesses neither the next window nor the wrapped stream.
+        const HRESULT result = fillWindow( mNextWindow, offset );
+        lock.lock();
+        mReadAheadResult = result;
+        mReadInProgress = false;
+        mReadCompleted.notify_one();
+    }
+}
+
+void CReadAheadInStream::startReadAhead() noexcept {
+    if ( mCurrentWindow.size < mCurrentWindow.capacity ) {
+        return; // The current window already reaches the end of the wrapped stream.
+    }
+
+    if ( !mReadAheadThread.joinable() ) {
+        try {
+            mReadAheadThread = std::thread( &CReadAheadInStream::runReadAhead, this );
+        } catch ( const std::system_error& ) {
+            return; // We could not start the helper thread: the next window will be read synchronously.
+        }
+    }
+
+    {
+        const std::lock_guard< std::mutex > lock{ mMutex };
+        mReadAheadOffset = mCurrentWindow.end();
+        mReadInProgress = true;
+    }
+    mReadPosted.notify_one();
+    mReadAheadPending = true;
+}
+
+void CReadAheadInStream::waitReadAhead() noexcept {
+    if ( !mReadAheadPending ) {
+        return;
+    }
+    std::unique_lock< std::mutex > lock{ mMutex };
+    mReadCompleted.wait( lock, [ this ]() -> bool {
+        return !mReadInProgress;
+    } );
+}
+
+auto CReadAheadInStream::loadWindow() noexcept -> HRESULT {
+    const bool isSequentialRead = mCurrentPosition == mCurrentWindow.end();
+    if ( mReadAheadPending ) {
+        waitReadAhead();
+        mReadAheadPending = false;
+        if ( mReadAheadResult == S_OK && mNextWindow.contains( mCurrentPosition ) ) {
+            std::swap( mCurrentWindow, mNextWindow );
+            startReadAhead();
+            return S_OK;
+        }
+    }
+
+    /* The read-ahead window (if any) is not the one needed by the reader, or it could not be read:
+     * we read the needed window synchronously (reporting any error to the reader). */
+    RINOK( fillWindow( mCurrentWindow, mCurrentPosition ) )
+
+    // Reading ahead is worth it only if the reader is consuming the stream sequentially.
+    if ( isSequentialRead ) {
+        startReadAhead();
+    }
+    return S_OK;
+}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CReadAheadInStream::Read( void* data, UInt32 size, UInt32* processedSize ) noexcept {
+    if ( processedSize != nullptr ) {
+        *processedSize = 0;
+    }
+
+    if ( size == 0 ) {
+        return S_OK;
+    }
+
+    if ( !mCurrentWindow.contains( mCurrentPosition ) ) {
+        RINOK( loadWindow() )
+        if ( !mCurrentWindow.contains( mCurrentPosition ) ) { // End of the wrapped stream.
+            return S_OK;
+        }
+    }
+
+    const auto windowIndex = static_cast< std::size_t >( mCurrentPosition - mCurrentWindow.offset );
+    const auto readSize = static_cast< UInt32 >( ( std::min )( mCurrentWindow.size - windowIndex,
+                                                               static_cast< std::size_t >( size ) ) );
+    std::memcpy( data, mCurrentWindow.buffer.get() + windowIndex, readSize );
+    mCurrentPosition += readSize;
+
+    if ( processedSize != nullptr ) {
+        *processedSize = readSize;
+    }
+    return S_OK;
+}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CReadAheadInStream::Seek( Int64 offset, UInt32 seekOrigin, UInt64* newPosition ) noexcept {
+    uint64_t seekPosition{};
+    switch ( seekOrigin ) {
+        case STREAM_SEEK_SET:
+            break;
+        case STREAM_SEEK_CUR:
+            seekPosition = mCurrentPosition;
+            break;
+        case STREAM_SEEK_END: {
+            // We need to access the wrapped stream, so we must wait for the read-ahead in progress (if any).
+            waitReadAhead();
+            RINOK( mInStream->Seek( 0, STREAM_SEEK_END, &mInStreamPosition ) )
+            seekPosition = mInStreamPosition;
+            break;
+        }
+        default:
+            return STG_E_INVALIDFUNCTION;
+    }
+
+    // Note: seeking doesn't access the wrapped stream, the windows are loaded lazily by the next Read.
+    RINOK( seek_to_offset( seekPosition, offset ) )
+    mCurrentPosition = seekPosition;
+
+    if ( newPosition != nullptr ) {
+        *newPosition = mCurrentPosition;
+    }
+    return S_OK;
+}
+
+} // namespace bit7z
@@ -0,0 +1,103 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CREADAHEADINSTREAM_HPP
+#define CREADAHEADINSTREAM_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "bittypes.hpp"
+#include "internal/com.hpp"
+#include "internal/guids.hpp"
+#include "internal/macros.hpp"
+
+#include <7zip/IStream.h>
+
+namespace bit7z {
+
+/**
+ * An input stream wrapping another one, and reading it in windows of a fixed size.
+ * While the current window is being consumed sequentially, the next one is read on a helper thread
+ * (started on the first read-ahead, and kept for the whole lifetime of the stream),
+ * so that the reader doesn't have to wait for the disk when reaching the end of the current window.
+ *
+ * @note The wrapped stream is only ever accessed by one thread at a time.
+ */
+class CReadAheadInStream final : public IInStream, public CMyUnknownImp {
+    public:
+        CReadAheadInStream( CMyComPtr< IInStream > inStream, std::size_t windowSize );
+
+        CReadAheadInStream( const CReadAheadInStream& ) = delete;
+
+        CReadAheadInStream( CReadAheadInStream&& ) = delete;
+
+        auto operator=( const CReadAheadInStream& ) -> CReadAheadInStream& = delete;
+
+        auto operator=( CReadAheadInStream&& ) -> CReadAheadInStream& = delete;
+
+        MY_UNKNOWN_DESTRUCTOR( ~CReadAheadInStream() );
+
+        // IInStream
+        BIT7Z_STDMETHOD( Read, void* data, UInt32 size, UInt32* processedSize );
+
+        BIT7Z_STDMETHOD( Seek, Int64 offset, UInt32 seekOrigin, UInt64* newPosition );
+
+        // NOLINTNEXTLINE(modernize-use-noexcept, modernize-use-trailing-return-type, readability-identifier-length)
+        MY_UNKNOWN_IMP1( IInStream ) //-V2507 //-V2511 //-V835
+
+    private:
+        struct Window {
+            std::unique_ptr< byte_t[] > buffer; // NOLINT(*-avoid-c-arrays)
+            std::size_t capacity;
+            uint64_t offset;
+            std::size_t size;
+
+            BIT7Z_NODISCARD auto contains( uint64_t position ) const noexcept -> bool;
+
+            BIT7Z_NODISCARD auto end() const noexcept -> uint64_t;
+        };
+
+        CMyComPtr< IInStream > mInStream;
+        uint64_t mInStreamPosition;
+        uint64_t mCurrentPosition;
+
+        Window mCurrentWindow;
+        Window mNextWindow;
+
+        // Whether the reader started a read-ahead and didn't use its result yet (accessed only by the reader).
+        bool mReadAheadPending;
+
+        // State shared with the helper thread (guarded by mMutex).
+        bool mReadInProgress;
+        bool mStopping;
+        uint64_t mReadAheadOffset;
+        HRESULT mReadAheadResult;
+        std::mutex mMutex;
+        std::condition_variable mReadPosted;
+        std::condition_variable mReadCompleted;
+        std::thread mReadAheadThread;
+
+        auto fillWindow( Window& window, uint64_t offset ) noexcept -> HRESULT;
+
+        void runReadAhead() noexcept;
+
+        void startReadAhead() noexcept;
+
+        void waitReadAhead() noexcept;
+
+        auto loadWindow() noexcept -> HRESULT;
+};
+
+}  // namespace bit7z
+
+#endif // CREADAHEADINSTREAM_HPP
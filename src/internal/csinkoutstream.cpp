@@ -0,0 +1,53 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <new>
+
+#include "internal/csinkoutstream.hpp"
+
+namespace bit7z {
+
+CSinkOutStream::CSinkOutStream( const ItemDataCallback& dataCallback,
+                                uint32_t index,
+                                std::exception_ptr& callbackException )
+    : mDataCallback( dataCallback ), mIndex( index ), mCallbackException( callbackException ) {}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CSinkOutStream::Write( const void* data, UInt32 size, UInt32* processedSize ) noexcept {
+    if ( processedSize != nullptr ) {
+        *processedSize = 0;
+    }
+
+    if ( size == 0 ) {
+        return S_OK;
+    }
+
+    try {
+        // The data is passed to the callback directly from the decoder's buffer, without copying it.
+        if ( !mDataCallback( mIndex, static_cast< const byte_t* >( data ), size ) ) {
+            return E_ABORT;
+        }
+    } catch ( const std::bad_alloc& ) {
+        mCallbackException = std::current_exception();
+        return E_OUTOFMEMORY;
+    } catch ( ... ) {
+        mCallbackException = std::current_exception();
+        return E_FAIL;
+    }
+
+    if ( processedSize != nullptr ) {
+        *processedSize = size;
+    }
+    return S_OK;
+}
+
+} // namespace bit7z
@@ -0,0 +1,58 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CSINKOUTSTREAM_HPP
+#define CSINKOUTSTREAM_HPP
+
+#include "bitinputarchive.hpp"
+#include "internal/com.hpp"
+#include "internal/guids.hpp"
+#include "internal/macros.hpp"
+
+#include <exception>
+
+#include <7zip/IStream.h>
+
+namespace bit7z {
+
+/**
+ * @brief An output stream forwarding the written data, as is, to the data callback of an ExtractSink.
+ *
+ * Any exception thrown by the callback is stored in the given exception pointer, so that it can be rethrown
+ * once the extraction has been stopped.
+ */
+class CSinkOutStream final : public ISequentialOutStream, public CMyUnknownImp {
+    public:
+        CSinkOutStream( const ItemDataCallback& dataCallback, uint32_t index, std::exception_ptr& callbackException );
+
+        CSinkOutStream( const CSinkOutStream& ) = delete;
+
+        CSinkOutStream( CSinkOutStream&& ) = delete;
+
+        auto operator=( const CSinkOutStream& ) -> CSinkOutStream& = delete;
+
+        auto operator=( CSinkOutStream&& ) -> CSinkOutStream& = delete;
+
+        MY_UNKNOWN_DESTRUCTOR( ~CSinkOutStream() ) = default;
+
+        // ISequentialOutStream
+        BIT7Z_STDMETHOD( Write, void const* data, UInt32 size, UInt32* processedSize );
+
+        // NOLINTNEXTLINE(modernize-use-noexcept, modernize-use-trailing-return-type, readability-identifier-length)
+        MY_UNKNOWN_IMP1( ISequentialOutStream ) //-V2507 //-V2511 //-V835
+
+    private:
+        const ItemDataCallback& mDataCallback;
+        uint32_t mIndex;
+        std::exception_ptr& mCallbackException;
+};
+
+}  // namespace bit7z
+
+#endif // CSINKOUTSTREAM_HPP
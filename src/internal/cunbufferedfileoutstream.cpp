@@ -0,0 +1,164 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "internal/cunbufferedfileoutstream.hpp"
+#include "internal/util.hpp"
+
+namespace bit7z {
+
+CUnbufferedFileOutStream::CUnbufferedFileOutStream( fs::path filePath, bool createAlways )
+    : CNativeFileOutStream( std::move( filePath ), createAlways, true ), mBufferOffset{ 0 }, mBufferedSize{ 0 } {
+    if ( !file().isUnbuffered() ) {
+        return; // The filesystem doesn't support unbuffered I/O, so we simply behave as a CNativeFileOutStream.
+    }
+    try {
+        mBuffer = BufferPool::acquireAligned( BufferPool::kMaxBufferSize );
+    } catch ( const std::bad_alloc& ) {
+        // Unaligned writes are not allowed for unbuffered files, so we must use the buffered access.
+        static_cast< void >( file().disableUnbuffered() );
+    }
+}
+
+CUnbufferedFileOutStream::~CUnbufferedFileOutStream() {
+    // Note: errors cannot be reported here; users that need them must call flush() before releasing the stream.
+    static_cast< void >( stopUnbuffered() );
+}
+
+auto CUnbufferedFileOutStream::flush() noexcept -> HRESULT {
+    RINOK( stopUnbuffered() )
+    return CNativeFileOutStream::flush();
+}
+
+auto CUnbufferedFileOutStream::writeAlignedBlocks() noexcept -> HRESULT {
+    const std::size_t alignedSize = mBufferedSize - ( mBufferedSize % FileHandle::kUnbufferedAlignment );
+    std::size_t writtenSize = 0;
+    while ( writtenSize < alignedSize ) {
+        const byte_t* chunkData = mBuffer.data() + writtenSize; //-V2563
+        const auto chunkSize = clamp_cast< UInt32 >( alignedSize - writtenSize );
+        const uint64_t chunkOffset = mBufferOffset + writtenSize;
+        UInt32 processedSize = 0;
+        HRESULT res = file().write( chunkData, chunkSize, chunkOffset, processedSize );
+        if ( res != S_OK && file().isUnbuffered() ) {
+            // Some filesystems accept unbuffered handles but then reject unbuffered writes:
+            // we switch to the buffered access and retry.
+            RINOK( file().disableUnbuffered() )
+            res = file().write( chunkData, chunkSize, chunkOffset, processedSize );
+        }
+        if ( res != S_OK ) {
+            return res;
+        }
+        if ( processedSize == 0 ) {
+            return E_FAIL;
+        }
+        writtenSize += processedSize;
+    }
+
+    /* Moving the remaining unaligned bytes (if any) at the beginning of the buffer. */
+    mBufferedSize -= alignedSize;
+    if ( mBufferedSize > 0 ) {
+        std::memmove( mBuffer.data(), mBuffer.data() + alignedSize, mBufferedSize );
+    }
+    mBufferOffset += alignedSize;
+    return S_OK;
+}
+
+auto CUnbufferedFileOutStream::stopUnbuffered() noexcept -> HRESULT {
+    if ( mBuffer.empty() ) {
+        return S_OK;
+    }
+
+    RINOK( writeAlignedBlocks() )
+
+    /* Writing the unaligned tail (if any) through the buffered access. */
+    RINOK( file().disableUnbuffered() )
+    std::size_t writtenSize = 0;
+    while ( writtenSize < mBufferedSize ) {
+        UInt32 processedSize = 0;
+        RINOK( file().write( mBuffer.data() + writtenSize,
+                             static_cast< UInt32 >( mBufferedSize - writtenSize ),
+                             mBufferOffset + writtenSize,
+                             processedSize ) )
+        if ( processedSize == 0 ) {
+            return E_FAIL;
+        }
+        writtenSize += processedSize;
+    }
+
+    const uint64_t currentPosition = mBufferOffset + mBufferedSize;
+    mBuffer.reset();
+    mBufferOffset = 0;
+    mBufferedSize = 0;
+
+    // From now on, the stream works as a normal (buffered) CNativeFileOutStream.
+    return CNativeFileOutStream::Seek( static_cast< Int64 >( currentPosition ), STREAM_SEEK_SET, nullptr );
+}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CUnbufferedFileOutStream::Write( const void* data, UInt32 size, UInt32* processedSize ) noexcept {
+    if ( mBuffer.empty() ) {
+        return CNativeFileOutStream::Write( data, size, processedSize );
+    }
+
+    if ( processedSize != nullptr ) {
+        *processedSize = 0;
+    }
+
+    const auto* byteData = static_cast< const byte_t* >( data ); //-V2571
+    UInt32 remainingSize = size;
+    while ( remainingSize > 0 ) {
+        const auto copySize = static_cast< UInt32 >( ( std::min )( static_cast< std::size_t >( remainingSize ),
+                                                                   mBuffer.size() - mBufferedSize ) );
+        std::memcpy( mBuffer.data() + mBufferedSize, byteData, copySize );
+        mBufferedSize += copySize;
+        byteData += copySize; //-V2563
+        remainingSize -= copySize;
+
+        if ( mBufferedSize == mBuffer.size() ) {
+            RINOK( writeAlignedBlocks() )
+        }
+    }
+
+    if ( processedSize != nullptr ) {
+        *processedSize = size;
+    }
+    return S_OK;
+}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CUnbufferedFileOutStream::Seek( Int64 offset, UInt32 seekOrigin, UInt64* newPosition ) noexcept {
+    if ( !mBuffer.empty() ) {
+        const uint64_t currentPosition = mBufferOffset + mBufferedSize;
+        const bool isCurrentPosition = offset >= 0 && static_cast< uint64_t >( offset ) == currentPosition;
+        if ( ( seekOrigin == STREAM_SEEK_CUR && offset == 0 ) ||
+             ( seekOrigin == STREAM_SEEK_SET && isCurrentPosition ) ) {
+            // Not moving from the current position, so we can keep writing sequentially.
+            if ( newPosition != nullptr ) {
+                *newPosition = currentPosition;
+            }
+            return S_OK;
+        }
+        RINOK( stopUnbuffered() )
+    }
+    return CNativeFileOutStream::Seek( offset, seekOrigin, newPosition );
+}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CUnbufferedFileOutStream::SetSize( UInt64 newSize ) noexcept {
+    RINOK( stopUnbuffered() )
+    return CNativeFileOutStream::SetSize( newSize );
+}
+
+} // namespace bit7z
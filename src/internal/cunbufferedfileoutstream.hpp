@@ -0,0 +1,62 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CUNBUFFEREDFILEOUTSTREAM_HPP
+#define CUNBUFFEREDFILEOUTSTREAM_HPP
+
+#include "internal/bufferpool.hpp"
+#include "internal/cnativefileoutstream.hpp"
+
+namespace bit7z {
+
+/**
+ * An output file stream bypassing the OS page cache, used for bulk extractions.
+ *
+ * Sequential writes are accumulated into an aligned buffer (taken from the BufferPool),
+ * which is written to the file in whole aligned blocks; the unaligned tail of the file is written
+ * through the normal buffered access when the stream is flushed.
+ * Non-sequential accesses (e.g., seeking to a different position), as well as filesystems not supporting
+ * unbuffered I/O, make the stream fall back to the buffered access of CNativeFileOutStream.
+ */
+class CUnbufferedFileOutStream final : public CNativeFileOutStream {
+    public:
+        explicit CUnbufferedFileOutStream( fs::path filePath, bool createAlways = false );
+
+        CUnbufferedFileOutStream( const CUnbufferedFileOutStream& ) = delete;
+
+        CUnbufferedFileOutStream( CUnbufferedFileOutStream&& ) = delete;
+
+        auto operator=( const CUnbufferedFileOutStream& ) -> CUnbufferedFileOutStream& = delete;
+
+        auto operator=( CUnbufferedFileOutStream&& ) -> CUnbufferedFileOutStream& = delete;
+
+        ~CUnbufferedFileOutStream() override;
+
+        auto flush() noexcept -> HRESULT override;
+
+        // IOutStream
+        BIT7Z_STDMETHOD( Write, const void* data, UInt32 size, UInt32* processedSize );
+
+        BIT7Z_STDMETHOD( Seek, Int64 offset, UInt32 seekOrigin, UInt64* newPosition );
+
+        BIT7Z_STDMETHOD( SetSize, UInt64 newSize );
+
+    private:
+        PooledBuffer mBuffer; // Empty if the stream is not (or no more) unbuffered.
+        uint64_t mBufferOffset; // The offset in the file of the first byte of the buffer (always aligned).
+        std::size_t mBufferedSize;
+
+        auto writeAlignedBlocks() noexcept -> HRESULT;
+
+        auto stopUnbuffered() noexcept -> HRESULT;
+};
+
+}  // namespace bit7z
+
+#endif // CUNBUFFEREDFILEOUTSTREAM_HPP
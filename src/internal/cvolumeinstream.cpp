@@ -10,12 +10,21 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 
+#include <utility>
+
+#include "bitexception.hpp"
 #include "internal/cvolumeinstream.hpp"
+#include "internal/filestreams.hpp"
+#include "internal/util.hpp"
 
 namespace bit7z {
 
-CVolumeInStream::CVolumeInStream( const fs::path& volumePath, uint64_t globalOffset )
-    : CFileInStream{ volumePath }, mSize{ fs::file_size( volumePath ) }, mGlobalOffset{ globalOffset } {}
+CVolumeInStream::CVolumeInStream( fs::path volumePath, uint64_t globalOffset )
+    : mVolumePath{ std::move( volumePath ) },
+      mSize{ fs::file_size( mVolumePath ) },
+      mGlobalOffset{ globalOffset },
+      mCurrentPosition{ 0 },
+      mFilePosition{ 0 } {}
 
 BIT7Z_NODISCARD
 auto CVolumeInStream::globalOffset() const -> uint64_t {
@@ -27,4 +36,70 @@ auto CVolumeInStream::size() const -> uint64_t {
     return mSize;
 }
 
-} // namespace bit7z
\ No newline at end of file
+void CVolumeInStream::close() {
+    mFileStream.Release();
+}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CVolumeInStream::Read( void* data, UInt32 size, UInt32* processedSize ) noexcept {
+    if ( processedSize != nullptr ) {
+        *processedSize = 0;
+    }
+
+    if ( size == 0 || mCurrentPosition >= mSize ) {
+        return S_OK;
+    }
+
+    if ( mFileStream == nullptr ) {
+        try {
+            mFileStream = bit7z::make_com< FileInStream, IInStream >( mVolumePath );
+            mFilePosition = 0;
+        } catch ( const BitException& ex ) {
+            return ex.nativeCode();
+        } catch ( const std::bad_alloc& ) {
+            return E_OUTOFMEMORY;
+        }
+    }
+
+    // Seeking the file only when needed (e.g., the first read after the volume was reopened).
+    if ( mFilePosition != mCurrentPosition ) {
+        RINOK( mFileStream->Seek( static_cast< Int64 >( mCurrentPosition ), STREAM_SEEK_SET, &mFilePosition ) )
+    }
+
+    UInt32 readSize = 0;
+    const HRESULT res = mFileStream->Read( data, size, &readSize );
+    mFilePosition += readSize;
+    mCurrentPosition += readSize;
+
+    if ( processedSize != nullptr ) {
+        *processedSize = readSize;
+    }
+    return res;
+}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CVolumeInStream::Seek( Int64 offset, UInt32 seekOrigin, UInt64* newPosition ) noexcept {
+    uint64_t seekPosition{};
+    switch ( seekOrigin ) {
+        case STREAM_SEEK_SET:
+            break;
+        case STREAM_SEEK_CUR:
+            seekPosition = mCurrentPosition;
+            break;
+        case STREAM_SEEK_END:
+            seekPosition = mSize;
+            break;
+        default:
+            return STG_E_INVALIDFUNCTION;
+    }
+
+    RINOK( seek_to_offset( seekPosition, offset ) )
+    mCurrentPosition = seekPosition;
+
+    if ( newPosition != nullptr ) {
+        *newPosition = mCurrentPosition;
+    }
+    return S_OK;
+}
+
+} // namespace bit7z
@@ -10,22 +10,58 @@
 #ifndef CVOLUMEINSTREAM_HPP
 #define CVOLUMEINSTREAM_HPP
 
-#include "internal/cfileinstream.hpp"
+#include "bitdefines.hpp"
+#include "internal/com.hpp"
+#include "internal/fs.hpp"
+#include "internal/guids.hpp"
+#include "internal/macros.hpp"
+
+#include <7zip/IStream.h>
 
 namespace bit7z {
 
-class CVolumeInStream final : public CFileInStream {
+/**
+ * An input stream over a single volume of a multi-volume archive.
+ * The volume file is opened lazily by the first read, and it can be closed at any time by the owner
+ * (e.g., to limit the number of open files); in this case, it is reopened by the next read.
+ */
+class CVolumeInStream final : public IInStream, public CMyUnknownImp {
     public:
-        explicit CVolumeInStream( const fs::path& volumePath, uint64_t globalOffset );
+        CVolumeInStream( fs::path volumePath, uint64_t globalOffset );
+
+        CVolumeInStream( const CVolumeInStream& ) = delete;
+
+        CVolumeInStream( CVolumeInStream&& ) = delete;
+
+        auto operator=( const CVolumeInStream& ) -> CVolumeInStream& = delete;
+
+        auto operator=( CVolumeInStream&& ) -> CVolumeInStream& = delete;
+
+        MY_UNKNOWN_DESTRUCTOR( ~CVolumeInStream() ) = default;
 
         BIT7Z_NODISCARD auto globalOffset() const -> uint64_t;
 
         BIT7Z_NODISCARD auto size() const -> uint64_t;
 
+        void close();
+
+        // IInStream
+        BIT7Z_STDMETHOD( Read, void* data, UInt32 size, UInt32* processedSize );
+
+        BIT7Z_STDMETHOD( Seek, Int64 offset, UInt32 seekOrigin, UInt64* newPosition );
+
+        // NOLINTNEXTLINE(modernize-use-noexcept, modernize-use-trailing-return-type, readability-identifier-length)
+        MY_UNKNOWN_IMP1( IInStream ) //-V2507 //-V2511 //-V835
+
     private:
+        fs::path mVolumePath;
         uint64_t mSize;
-
         uint64_t mGlobalOffset;
+        uint64_t mCurrentPosition;
+
+        // The stream of the volume file (nullptr if the file is not open) and its current position.
+        CMyComPtr< IInStream > mFileStream;
+        uint64_t mFilePosition;
 };
 
 }  // namespace bit7z
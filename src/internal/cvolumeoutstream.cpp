@@ -10,20 +10,71 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 
+#include <utility>
+
+#include "bitexception.hpp"
 #include "internal/cvolumeoutstream.hpp"
+#include "internal/util.hpp"
 
 namespace bit7z {
 
-CVolumeOutStream::CVolumeOutStream( const fs::path& volumeName )
-    : CFileOutStream( volumeName ), mCurrentOffset{ 0 }, mCurrentSize{ 0 } {}
+CVolumeOutStream::CVolumeOutStream( fs::path volumePath )
+    : mVolumePath{ std::move( volumePath ) },
+      mFile{ make_com< FileOutStream >( mVolumePath, FileOpenMode::CreateNew ) },
+      mFilePosition{ 0 },
+      mCurrentOffset{ 0 },
+      mCurrentSize{ 0 } {}
+
+auto CVolumeOutStream::path() const -> const fs::path& {
+    return mVolumePath;
+}
+
+auto CVolumeOutStream::isOpen() const -> bool {
+    return mFile != nullptr;
+}
+
+auto CVolumeOutStream::close() noexcept -> HRESULT {
+    if ( !isOpen() ) {
+        return S_OK;
+    }
+    const HRESULT result = mFile->flush();
+    mFile.Release();
+    return result;
+}
+
+auto CVolumeOutStream::reopen() noexcept -> HRESULT {
+    try {
+        mFile = make_com< FileOutStream >( mVolumePath, FileOpenMode::OpenExisting );
+        mFilePosition = 0;
+    } catch ( const BitException& ex ) {
+        return ex.nativeCode();
+    } catch ( const std::bad_alloc& ) {
+        return E_OUTOFMEMORY;
+    }
+    return S_OK;
+}
 
 COM_DECLSPEC_NOTHROW
 STDMETHODIMP CVolumeOutStream::Seek( Int64 offset, UInt32 seekOrigin, UInt64* newPosition ) noexcept {
-    UInt64 pos{};
-    RINOK( CStdOutStream::Seek( offset, seekOrigin, &pos ) )
-    mCurrentOffset = pos;
+    uint64_t seekPosition{};
+    switch ( seekOrigin ) {
+        case STREAM_SEEK_SET:
+            break;
+        case STREAM_SEEK_CUR:
+            seekPosition = mCurrentOffset;
+            break;
+        case STREAM_SEEK_END:
+            seekPosition = mCurrentSize;
+            break;
+        default:
+            return STG_E_INVALIDFUNCTION;
+    }
+
+    RINOK( seek_to_offset( seekPosition, offset ) )
+    mCurrentOffset = seekPosition;
+
     if ( newPosition != nullptr ) {
-        *newPosition = pos;
+        *newPosition = mCurrentOffset;
     }
     return S_OK;
 }
@@ -34,8 +85,18 @@ STDMETHODIMP CVolumeOutStream::Write( const void* data, UInt32 size, UInt32* pro
         *processedSize = 0;
     }
 
+    if ( !isOpen() ) {
+        RINOK( reopen() )
+    }
+
+    // Seeking the file only when needed (e.g., the first write after the volume was reopened).
+    if ( mFilePosition != mCurrentOffset ) {
+        RINOK( mFile->Seek( static_cast< Int64 >( mCurrentOffset ), STREAM_SEEK_SET, &mFilePosition ) )
+    }
+
     UInt32 writtenSize{};
-    RINOK( CStdOutStream::Write( data, size, &writtenSize ) )
+    RINOK( mFile->Write( data, size, &writtenSize ) )
+    mFilePosition += writtenSize;
 
     if ( writtenSize == 0 && size != 0 ) {
         return E_FAIL;
@@ -54,7 +115,10 @@ auto CVolumeOutStream::currentOffset() const -> uint64_t {
 
 COM_DECLSPEC_NOTHROW
 STDMETHODIMP CVolumeOutStream::SetSize( UInt64 newSize ) noexcept {
-    RINOK( CFileOutStream::SetSize( newSize ) )
+    if ( !isOpen() ) {
+        RINOK( reopen() )
+    }
+    RINOK( mFile->SetSize( newSize ) )
     mCurrentSize = newSize;
     return S_OK;
 }
@@ -67,4 +131,4 @@ void CVolumeOutStream::setCurrentSize( uint64_t currentSize ) {
     mCurrentSize = currentSize;
 }
 
-} // namespace bit7z
\ No newline at end of file
+} // namespace bit7z
@@ -10,13 +10,37 @@
 #ifndef CVOLUMEOUTSTREAM_HPP
 #define CVOLUMEOUTSTREAM_HPP
 
-#include "internal/cfileoutstream.hpp"
+#include "bitdefines.hpp"
+#include "internal/com.hpp"
+#include "internal/filestreams.hpp"
+#include "internal/fs.hpp"
+#include "internal/guids.hpp"
+#include "internal/macros.hpp"
+
+#include <7zip/IStream.h>
 
 namespace bit7z {
 
-class CVolumeOutStream final : public CFileOutStream {
+/**
+ * An output stream over a single volume of a multi-volume archive.
+ * The volume file can be closed at any time by the owner (e.g., when the volume has been completely written);
+ * in this case, it is reopened (without truncating it) by the next write.
+ */
+class CVolumeOutStream final : public IOutStream, public CMyUnknownImp {
     public:
-        explicit CVolumeOutStream( const fs::path& volumeName );
+        explicit CVolumeOutStream( fs::path volumePath );
+
+        CVolumeOutStream( const CVolumeOutStream& ) = delete;
+
+        CVolumeOutStream( CVolumeOutStream&& ) = delete;
+
+        auto operator=( const CVolumeOutStream& ) -> CVolumeOutStream& = delete;
+
+        auto operator=( CVolumeOutStream&& ) -> CVolumeOutStream& = delete;
+
+        MY_UNKNOWN_DESTRUCTOR( ~CVolumeOutStream() ) = default;
+
+        BIT7Z_NODISCARD auto path() const -> const fs::path&;
 
         BIT7Z_NODISCARD auto currentOffset() const -> uint64_t;
 
@@ -24,6 +48,11 @@ class CVolumeOutStream final : public CFileOutStream {
 
         void setCurrentSize( uint64_t currentSize );
 
+        BIT7Z_NODISCARD auto isOpen() const -> bool;
+
+        // Flushes and closes the volume file; it returns an error code if the buffered data couldn't be written.
+        auto close() noexcept -> HRESULT;
+
         // IOutStream
         BIT7Z_STDMETHOD( Write, void const* data, UInt32 size, UInt32* processedSize );
 
@@ -31,10 +60,21 @@ class CVolumeOutStream final : public CFileOutStream {
 
         BIT7Z_STDMETHOD( SetSize, UInt64 newSize );
 
+        // NOLINTNEXTLINE(modernize-use-noexcept, modernize-use-trailing-return-type, readability-identifier-length)
+        MY_UNKNOWN_IMP1( IOutStream ) //-V2507 //-V2511 //-V835
+
     private:
+        fs::path mVolumePath;
+
+        // The stream of the volume file (nullptr if the file is closed) and its current position.
+        CMyComPtr< FileOutStream > mFile;
+        uint64_t mFilePosition;
+
         uint64_t mCurrentOffset;
 
         uint64_t mCurrentSize;
+
+        auto reopen() noexcept -> HRESULT;
 };
 
 }  // namespace bit7z
@@ -40,6 +40,24 @@ auto time_to_FILETIME( std::time_t timeValue ) -> FILETIME {
     return fileTime;
 }
 
+auto FILETIME_to_timespec( FILETIME fileTime ) noexcept -> timespec {
+    const FileTimeDuration fileTimeDuration{
+        ( static_cast< int64_t >( fileTime.dwHighDateTime ) << 32 ) + fileTime.dwLowDateTime
+    };
+
+    const auto unixEpoch = fileTimeDuration + nt_to_unix_epoch;
+    auto seconds = std::chrono::duration_cast< std::chrono::seconds >( unixEpoch );
+    if ( seconds > unixEpoch ) { // Times before the Unix epoch must be rounded down.
+        seconds -= std::chrono::seconds{ 1 };
+    }
+    const auto nanoseconds = std::chrono::duration_cast< std::chrono::nanoseconds >( unixEpoch - seconds );
+
+    timespec result{};
+    result.tv_sec = static_cast< std::time_t >( seconds.count() );
+    result.tv_nsec = static_cast< long >( nanoseconds.count() ); // NOLINT(google-runtime-int)
+    return result;
+}
+
 #endif
 
 auto FILETIME_to_time_type( FILETIME fileTime ) -> time_type {
@@ -25,6 +25,8 @@ auto FILETIME_to_file_time_type( FILETIME fileTime ) -> fs::file_time_type;
 
 auto time_to_FILETIME( std::time_t timeValue ) -> FILETIME;
 
+auto FILETIME_to_timespec( FILETIME fileTime ) noexcept -> timespec;
+
 #endif
 
 auto FILETIME_to_time_type( FILETIME fileTime ) -> time_type;
@@ -0,0 +1,51 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <system_error>
+#include <utility>
+
+#include "internal/directorycache.hpp"
+
+namespace bit7z {
+
+void DirectoryCache::createDirectories( const fs::path& directory ) {
+    if ( directory.empty() ) {
+        return;
+    }
+
+    {
+        const std::lock_guard< std::mutex > lock{ mMutex };
+        if ( mCreatedDirectories.find( directory.native() ) != mCreatedDirectories.end() ) {
+            return;
+        }
+    }
+
+    // Note: the directories are created outside the lock, as they might be created concurrently by other threads.
+    std::error_code error;
+    fs::create_directories( directory, error );
+    if ( error ) {
+        return;
+    }
+
+    // The parent directories exist too, so we cache them as well (until we find one already cached).
+    const std::lock_guard< std::mutex > lock{ mMutex };
+    fs::path current = directory;
+    while ( !current.empty() && mCreatedDirectories.insert( current.native() ).second ) {
+        fs::path parent = current.parent_path();
+        if ( parent == current ) { // Root directory.
+            break;
+        }
+        current = std::move( parent );
+    }
+}
+
+} // namespace bit7z
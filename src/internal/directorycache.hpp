@@ -0,0 +1,55 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef DIRECTORYCACHE_HPP
+#define DIRECTORYCACHE_HPP
+
+#include <mutex>
+#include <unordered_set>
+
+#include "internal/fs.hpp"
+
+namespace bit7z {
+
+/**
+ * @brief Remembers the directories already created during an extraction, so that the extraction of each item
+ *        doesn't need to walk its output path again to check whether its parent directories exist.
+ *
+ * The cache can be safely used by multiple threads (e.g., the writer threads of an extraction).
+ */
+class DirectoryCache final {
+    public:
+        DirectoryCache() = default;
+
+        DirectoryCache( const DirectoryCache& ) = delete;
+
+        DirectoryCache( DirectoryCache&& ) = delete;
+
+        auto operator=( const DirectoryCache& ) -> DirectoryCache& = delete;
+
+        auto operator=( DirectoryCache&& ) -> DirectoryCache& = delete;
+
+        ~DirectoryCache() = default;
+
+        /**
+         * @brief Creates the given directory (and its parents), unless it is already known to exist.
+         *
+         * @note Errors are not reported, and the directory is not cached: they will surface when
+         *       creating files inside the directory.
+         */
+        void createDirectories( const fs::path& directory );
+
+    private:
+        std::mutex mMutex;
+        std::unordered_set< fs::path::string_type > mCreatedDirectories;
+};
+
+}  // namespace bit7z
+
+#endif // DIRECTORYCACHE_HPP
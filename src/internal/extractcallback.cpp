@@ -23,7 +23,9 @@ ExtractCallback::ExtractCallback( const BitInputArchive& inputArchive )
     : Callback( inputArchive.handler() ),
       mInputArchive( inputArchive ),
       mExtractMode( ExtractMode::Extract ),
-      mIsLastItemEncrypted{ false } {}
+      mIsLastItemEncrypted{ false },
+      mParallelContext{ nullptr },
+      mWorkerIndex{ 0 } {}
 
 auto ExtractCallback::finishOperation( OperationResult operationResult ) -> HRESULT {
     releaseStream();
@@ -32,6 +34,10 @@ auto ExtractCallback::finishOperation( OperationResult operationResult ) -> HRES
 
 COM_DECLSPEC_NOTHROW
 STDMETHODIMP ExtractCallback::SetTotal( UInt64 size ) noexcept {
+    if ( mParallelContext != nullptr ) {
+        mParallelContext->setTotal( mWorkerIndex, size );
+        return S_OK;
+    }
     if ( mHandler.totalCallback() ) {
         mHandler.totalCallback()( size );
     }
@@ -40,6 +46,12 @@ STDMETHODIMP ExtractCallback::SetTotal( UInt64 size ) noexcept {
 
 COM_DECLSPEC_NOTHROW
 STDMETHODIMP ExtractCallback::SetCompleted( const UInt64* completeValue ) noexcept {
+    if ( mParallelContext != nullptr ) {
+        const bool shouldContinue = completeValue != nullptr ?
+                                    mParallelContext->setCompleted( mWorkerIndex, *completeValue ) :
+                                    !mParallelContext->aborted();
+        return shouldContinue ? S_OK : E_ABORT;
+    }
     if ( mHandler.progressCallback() && completeValue != nullptr ) {
         return mHandler.progressCallback()( *completeValue ) ? S_OK : E_ABORT;
     }
@@ -48,6 +60,12 @@ STDMETHODIMP ExtractCallback::SetCompleted( const UInt64* completeValue ) noexce
 
 COM_DECLSPEC_NOTHROW
 STDMETHODIMP ExtractCallback::SetRatioInfo( const UInt64* inSize, const UInt64* outSize ) noexcept {
+    if ( mParallelContext != nullptr ) {
+        if ( inSize != nullptr && outSize != nullptr ) {
+            mParallelContext->setRatioInfo( mWorkerIndex, *inSize, *outSize );
+        }
+        return S_OK;
+    }
     if ( mHandler.ratioCallback() && inSize != nullptr && outSize != nullptr ) {
         mHandler.ratioCallback()( *inSize, *outSize );
     }
@@ -123,6 +141,7 @@ STDMETHODIMP ExtractCallback::CryptoGetTextPassword( BSTR* password ) noexcept {
     std::wstring pass;
     if ( !mHandler.isPasswordDefined() ) {
         if ( mHandler.passwordCallback() ) {
+            const auto lock = lockCallbacks();
             pass = WIDEN( mHandler.passwordCallback()() );
         }
 
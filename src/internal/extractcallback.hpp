@@ -16,6 +16,7 @@
 #include "internal/callback.hpp"
 #include "internal/macros.hpp"
 #include "internal/operationresult.hpp"
+#include "internal/parallelextractcontext.hpp"
 
 #include <7zip/Archive/IArchive.h>
 #include <7zip/ICoder.h>
@@ -73,6 +74,15 @@ class ExtractCallback : public Callback,
             return mErrorException;
         }
 
+        /**
+         * @brief Makes the callback act as the given worker of a parallel extraction,
+         *        reporting its progress to the shared context.
+         */
+        inline void setParallelContext( ParallelExtractContext* context, std::size_t workerIndex ) noexcept {
+            mParallelContext = context;
+            mWorkerIndex = workerIndex;
+        }
+
         // NOLINTNEXTLINE(modernize-use-noexcept, modernize-use-trailing-return-type, readability-identifier-length)
         MY_UNKNOWN_IMP3( IArchiveExtractCallback, ICompressProgressInfo, ICryptoGetTextPassword ) //-V2507 //-V2511 //-V835
 
@@ -99,6 +109,15 @@ class ExtractCallback : public Callback,
             return mInputArchive;
         }
 
+        /**
+         * @return a lock serializing the calls to the user callbacks among the workers of a parallel extraction
+         *         (an empty lock when the extraction is not parallel).
+         */
+        BIT7Z_NODISCARD
+        inline auto lockCallbacks() const -> std::unique_lock< std::mutex > {
+            return mParallelContext != nullptr ? mParallelContext->lockCallbacks() : std::unique_lock< std::mutex >{};
+        }
+
         virtual auto finishOperation( OperationResult operationResult ) -> HRESULT;
 
         virtual void releaseStream() = 0;
@@ -110,6 +129,8 @@ class ExtractCallback : public Callback,
         ExtractMode mExtractMode;
         bool mIsLastItemEncrypted;
         std::exception_ptr mErrorException;
+        ParallelExtractContext* mParallelContext;
+        std::size_t mWorkerIndex;
 };
 
 }  // namespace bit7z
@@ -25,42 +25,75 @@ FileExtractCallback::FileExtractCallback( const BitInputArchive& inputArchive, c
     : ExtractCallback( inputArchive ),
       mInFilePath( tstring_to_path( inputArchive.archivePath() ) ),
       mDirectoryPath( tstring_to_path( directoryPath ) ),
-      mRetainDirectories( inputArchive.handler().retainDirectories() ) {}
+      mRetainDirectories( inputArchive.handler().retainDirectories() ),
+      mDirectoryCache{ std::make_shared< DirectoryCache >() },
+      mWriterPool{ nullptr } {}
 
 void FileExtractCallback::releaseStream() {
     mFileOutStream.Release(); // We need to release the file to change its modified time!
+    mAsyncOutStream.Release();
+}
+
+/* Restores the metadata of an extracted file, preferably through its still open output stream (avoiding further
+ * path lookups); the metadata that cannot be restored this way is set by path, after releasing the stream. */
+inline void restore_file_metadata( CMyComPtr< FileOutStream >& outStream,
+                                   const fs::path& filePath,
+                                   const ProcessedItem& item ) {
+#ifdef _WIN32
+    const auto creationTime = item.hasCreationTime() ? item.creationTime() : FILETIME{};
+    const auto accessTime = item.hasAccessTime() ? item.accessTime() : FILETIME{};
+    const auto modifiedTime = item.hasModifiedTime() ? item.modifiedTime() : FILETIME{};
+    const bool timesRestored = outStream->setFileTime( creationTime, accessTime, modifiedTime ) == S_OK;
+    // Note: on Windows, attributes are set by path, but it is a single call that doesn't need to reopen the file.
+    const bool attributesRestored = false;
+#else
+    const bool timesRestored = !item.hasModifiedTime() || outStream->setModifiedTime( item.modifiedTime() ) == S_OK;
+    const bool attributesRestored = !item.areAttributesDefined() ||
+                                    outStream->setAttributes( item.attributes() ) == S_OK;
+#endif
+    outStream.Release();
+
+    if ( !timesRestored ) {
+#ifdef _WIN32
+        filesystem::fsutil::set_file_time( filePath, creationTime, accessTime, modifiedTime );
+#else
+        filesystem::fsutil::set_file_modified_time( filePath, item.modifiedTime() );
+#endif
+    }
+
+    if ( !attributesRestored && item.areAttributesDefined() ) {
+        filesystem::fsutil::set_file_attributes( filePath, item.attributes() );
+    }
 }
 
 auto FileExtractCallback::finishOperation( OperationResult operationResult ) -> HRESULT {
     const HRESULT result = operationResult != OperationResult::Success ? E_FAIL : S_OK;
+    if ( mAsyncOutStream != nullptr ) {
+        CAsyncFileOutStream::CloseFunction beforeClose;
+        if ( extractMode() == ExtractMode::Extract ) {
+            beforeClose = [ filePath = mFilePathOnDisk, item = mCurrentItem ]( CMyComPtr< FileOutStream >& outStream ) {
+                restore_file_metadata( outStream, filePath, item );
+            };
+        }
+        const HRESULT closeResult = mAsyncOutStream->close( std::move( beforeClose ) );
+        mAsyncOutStream.Release();
+        return closeResult != S_OK ? closeResult : result;
+    }
+
     if ( mFileOutStream == nullptr ) {
         return result;
     }
 
-    if ( mFileOutStream->fail() ) {
+    if ( mFileOutStream->flush() != S_OK || mFileOutStream->fail() ) {
         return E_FAIL;
     }
 
-    mFileOutStream.Release(); // We need to release the file to change its modified time!
-
     if ( extractMode() != ExtractMode::Extract ) { // No need to set attributes or modified time of the file.
+        mFileOutStream.Release();
         return result;
     }
 
-#ifdef _WIN32
-    const auto creationTime = mCurrentItem.hasCreationTime() ? mCurrentItem.creationTime() : FILETIME{};
-    const auto accessTime = mCurrentItem.hasAccessTime() ? mCurrentItem.accessTime() : FILETIME{};
-    const auto modifiedTime = mCurrentItem.hasModifiedTime() ? mCurrentItem.modifiedTime() : FILETIME{};
-    filesystem::fsutil::set_file_time( mFilePathOnDisk, creationTime, accessTime, modifiedTime );
-#else
-    if ( mCurrentItem.hasModifiedTime() ) {
-        filesystem::fsutil::set_file_modified_time( mFilePathOnDisk, mCurrentItem.modifiedTime() );
-    }
-#endif
-
-    if ( mCurrentItem.areAttributesDefined() ) {
-        filesystem::fsutil::set_file_attributes( mFilePathOnDisk, mCurrentItem.attributes() );
-    }
+    restore_file_metadata( mFileOutStream, mFilePathOnDisk, mCurrentItem ); // Note: it also releases the stream.
     return result;
 }
 
@@ -78,6 +111,75 @@ auto FileExtractCallback::getCurrentItemPath() const -> fs::path {
 
 constexpr auto kCannotDeleteOutput = "Cannot delete output file";
 
+inline auto create_output_stream( const BitAbstractArchiveHandler& handler,
+                                  const fs::path& filePathOnDisk,
+                                  const BitPropVariant& sizeProp,
+                                  bool createAlways ) -> CMyComPtr< FileOutStream > {
+#ifndef BIT7Z_USE_STD_FILE_STREAMS
+    static_cast< void >( sizeProp );
+    return handler.extractionOptions().unbuffered ?
+           bit7z::make_com< CUnbufferedFileOutStream, FileOutStream >( filePathOnDisk, createAlways ) :
+           bit7z::make_com< FileOutStream >( filePathOnDisk, createAlways );
+#else
+    static_cast< void >( handler );
+    // The item's size lets the stream use a buffer of the right size (i.e., small files get small buffers).
+    const uint64_t sizeHint = sizeProp.isUInt64() ? sizeProp.getUInt64() : BufferPool::kMaxBufferSize;
+    return bit7z::make_com< FileOutStream >( filePathOnDisk, createAlways, sizeHint );
+#endif
+}
+
+/* Creates the output file of an item, handling existing files as specified by the handler's overwrite mode;
+ * it returns a null stream if the item must not be extracted (i.e., when skipping existing files). */
+inline auto open_output_file( const BitAbstractArchiveHandler& handler,
+                              DirectoryCache& directoryCache,
+                              const fs::path& filePathOnDisk,
+                              const BitPropVariant& sizeProp ) -> CMyComPtr< FileOutStream > {
+    directoryCache.createDirectories( filePathOnDisk.parent_path() );
+
+    /* Usually, the output file doesn't exist yet, so rather than checking for its existence first,
+     * we try to exclusively create it, and apply the overwrite mode only if the creation failed
+     * because the file already exists. */
+    CMyComPtr< FileOutStream > outStream;
+    try {
+        outStream = create_output_stream( handler, filePathOnDisk, sizeProp, false );
+    } catch ( const BitException& ex ) {
+        if ( ex.code() != std::errc::file_exists ) {
+            throw;
+        }
+    }
+
+    if ( outStream == nullptr ) {
+        switch ( handler.overwriteMode() ) {
+            case OverwriteMode::None: {
+                throw BitException( kCannotDeleteOutput,
+                                    make_hresult_code( E_ABORT ),
+                                    path_to_tstring( filePathOnDisk ) );
+            }
+            case OverwriteMode::Skip: {
+                return nullptr;
+            }
+            case OverwriteMode::Overwrite:
+            default: {
+                std::error_code error;
+                if ( !fs::remove( filePathOnDisk, error ) ) {
+                    throw BitException( kCannotDeleteOutput,
+                                        make_hresult_code( E_ABORT ),
+                                        path_to_tstring( filePathOnDisk ) );
+                }
+                outStream = create_output_stream( handler, filePathOnDisk, sizeProp, true );
+                break;
+            }
+        }
+    }
+
+    const uint64_t itemSize = sizeProp.isUInt64() ? sizeProp.getUInt64() : 0;
+    if ( handler.extractionOptions().preallocateFiles && itemSize > 0 ) {
+        // Preallocation is just an optimization, so we can ignore failures (e.g., unsupported filesystem).
+        static_cast< void >( outStream->preallocate( itemSize ) );
+    }
+    return outStream;
+}
+
 auto FileExtractCallback::getOutStream( uint32_t index, ISequentialOutStream** outStream ) -> HRESULT {
     mCurrentItem.loadItemInfo( inputArchive(), index );
 
@@ -106,42 +208,41 @@ auto FileExtractCallback::getOutStream( uint32_t index, ISequentialOutStream** o
             const auto& nativePath = filePath.native();
             const auto filePathString = narrow( nativePath.c_str(), nativePath.size() );
 #endif
+            const auto lock = lockCallbacks();
             mHandler.fileCallback()( filePathString );
         }
 
-        std::error_code error;
-        fs::create_directories( mFilePathOnDisk.parent_path(), error );
-
-        if ( fs::exists( mFilePathOnDisk, error ) ) {
-            const OverwriteMode overwriteMode = mHandler.overwriteMode();
-
-            switch ( overwriteMode ) {
-                case OverwriteMode::None: {
-                    throw BitException( kCannotDeleteOutput,
-                                        make_hresult_code( E_ABORT ),
-                                        path_to_tstring( mFilePathOnDisk ) );
-                }
-                case OverwriteMode::Skip: {
-                    return S_OK;
-                }
-                case OverwriteMode::Overwrite:
-                default: {
-                    if ( !fs::remove( mFilePathOnDisk, error ) ) {
-                        throw BitException( kCannotDeleteOutput,
-                                            make_hresult_code( E_ABORT ),
-                                            path_to_tstring( mFilePathOnDisk ) );
-                    }
-                    break;
-                }
-            }
+        const BitPropVariant sizeProp = itemProperty( index, BitProperty::Size );
+        if ( mWriterPool != nullptr ) {
+            // The output file is opened, written, and closed by the writer threads.
+            const uint64_t sizeHint = sizeProp.isUInt64() ? sizeProp.getUInt64() : CAsyncFileOutStream::kChunkSize;
+            const auto& handler = mHandler;
+            auto asyncOutStream = bit7z::make_com< CAsyncFileOutStream >(
+                *mWriterPool, mFilePathOnDisk, sizeHint,
+                [ &handler, directoryCache = mDirectoryCache, filePathOnDisk = mFilePathOnDisk, sizeProp ]()
+                    -> CMyComPtr< FileOutStream > {
+                    return open_output_file( handler, *directoryCache, filePathOnDisk, sizeProp );
+                } );
+            mAsyncOutStream = asyncOutStream;
+            *outStream = asyncOutStream.Detach();
+            return S_OK;
         }
 
-        auto outStreamLoc = bit7z::make_com< CFileOutStream >( mFilePathOnDisk, true );
+        auto outStreamLoc = open_output_file( mHandler, *mDirectoryCache, mFilePathOnDisk, sizeProp );
+        if ( outStreamLoc == nullptr ) { // Skipping the existing file.
+            return S_OK;
+        }
         mFileOutStream = outStreamLoc;
         *outStream = outStreamLoc.Detach();
     } else if ( mRetainDirectories ) { // Directory, and we must retain it
-        std::error_code error;
-        fs::create_directories( mFilePathOnDisk, error );
+        if ( mWriterPool != nullptr ) {
+            mWriterPool->post( mWriterPool->laneFor( mFilePathOnDisk ),
+                               [ directoryCache = mDirectoryCache, directoryPath = mFilePathOnDisk ]() {
+                                   directoryCache->createDirectories( directoryPath );
+                               } );
+            return S_OK;
+        }
+        mDirectoryCache->createDirectories( mFilePathOnDisk );
     } else {
         // No action needed
     }
@@ -10,9 +10,16 @@
 #ifndef FILEEXTRACTCALLBACK_HPP
 #define FILEEXTRACTCALLBACK_HPP
 
+#include <memory>
 #include <string>
 
-#include "internal/cfileoutstream.hpp"
+#include "internal/asyncwriterpool.hpp"
+#include "internal/casyncfileoutstream.hpp"
+#include "internal/directorycache.hpp"
+#include "internal/filestreams.hpp"
+#ifndef BIT7Z_USE_STD_FILE_STREAMS
+#include "internal/cunbufferedfileoutstream.hpp"
+#endif
 #include "internal/extractcallback.hpp"
 #include "internal/processeditem.hpp"
 
@@ -34,15 +41,27 @@ class FileExtractCallback final : public ExtractCallback {
 
         ~FileExtractCallback() override = default;
 
+        /**
+         * @brief Makes the callback leave the filesystem work (e.g., writing the extracted files)
+         *        to the given pool of writer threads, instead of doing it in the decoder thread.
+         */
+        inline void setWriterPool( AsyncWriterPool* writerPool ) noexcept {
+            mWriterPool = writerPool;
+        }
+
     private:
         fs::path mInFilePath;     // Input file path
         fs::path mDirectoryPath;  // Output directory
         fs::path mFilePathOnDisk; // Full path to the file on disk
         bool mRetainDirectories;
+        std::shared_ptr< DirectoryCache > mDirectoryCache; // Shared with the tasks of the writer threads.
 
         ProcessedItem mCurrentItem;
 
-        CMyComPtr< CFileOutStream > mFileOutStream;
+        CMyComPtr< FileOutStream > mFileOutStream;
+
+        AsyncWriterPool* mWriterPool;
+        CMyComPtr< CAsyncFileOutStream > mAsyncOutStream;
 
         auto finishOperation( OperationResult operationResult ) -> HRESULT override;
 
@@ -0,0 +1,293 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "bitexception.hpp"
+#include "internal/filehandle.hpp"
+#include "internal/stringutil.hpp"
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace bit7z {
+
+namespace {
+auto open_error_message( FileOpenMode mode ) noexcept -> const char* {
+    switch ( mode ) {
+        case FileOpenMode::CreateNew:
+            return "Failed to create the output file";
+        case FileOpenMode::CreateAlways:
+        case FileOpenMode::OpenExisting:
+            return "Failed to open the output file";
+        case FileOpenMode::Read:
+        default:
+            return "Failed to open the archive file";
+    }
+}
+
+#ifdef _WIN32
+constexpr DWORD kUnbufferedFlags = FILE_FLAG_NO_BUFFERING | FILE_FLAG_WRITE_THROUGH;
+
+/* Note: unbuffered handles also share the write access, so that they can be reopened as buffered handles
+ *       via ReOpenFile (see FileHandle::disableUnbuffered). */
+auto open_file( const fs::path& filePath, FileOpenMode mode, bool unbuffered ) noexcept -> native_handle_t {
+    const DWORD flags = unbuffered ? ( FILE_ATTRIBUTE_NORMAL | kUnbufferedFlags ) : FILE_ATTRIBUTE_NORMAL;
+    const DWORD writeShareMode = unbuffered ? ( FILE_SHARE_READ | FILE_SHARE_WRITE ) : FILE_SHARE_READ;
+    switch ( mode ) {
+        case FileOpenMode::CreateNew:
+            return ::CreateFileW( filePath.c_str(), GENERIC_WRITE, writeShareMode,
+                                  nullptr, CREATE_NEW, flags, nullptr );
+        case FileOpenMode::CreateAlways:
+            return ::CreateFileW( filePath.c_str(), GENERIC_WRITE, writeShareMode,
+                                  nullptr, CREATE_ALWAYS, flags, nullptr );
+        case FileOpenMode::OpenExisting:
+            return ::CreateFileW( filePath.c_str(), GENERIC_WRITE, writeShareMode,
+                                  nullptr, OPEN_EXISTING, flags, nullptr );
+        case FileOpenMode::Read:
+        default:
+            return ::CreateFileW( filePath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                                  nullptr, OPEN_EXISTING, flags, nullptr );
+    }
+}
+
+constexpr auto kInvalidHandle = INVALID_HANDLE_VALUE;
+
+auto make_overlapped( uint64_t offset ) noexcept -> OVERLAPPED {
+    OVERLAPPED overlapped{};
+    overlapped.Offset = static_cast< DWORD >( offset & 0xFFFFFFFFu );
+    overlapped.OffsetHigh = static_cast< DWORD >( offset >> 32u );
+    return overlapped;
+}
+#else
+auto open_flags( FileOpenMode mode ) noexcept -> int {
+    switch ( mode ) {
+        case FileOpenMode::CreateNew:
+            return O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC;
+        case FileOpenMode::CreateAlways:
+            return O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+        case FileOpenMode::OpenExisting:
+            return O_WRONLY | O_CLOEXEC;
+        case FileOpenMode::Read:
+        default:
+            return O_RDONLY | O_CLOEXEC;
+    }
+}
+
+auto open_file( const fs::path& filePath, FileOpenMode mode, bool /*unbuffered*/ ) noexcept -> native_handle_t {
+    constexpr auto kDefaultPermissions = 0666; // Note: the process umask is applied to this value by the OS.
+    int result{};
+    do {
+        result = ::open( filePath.c_str(), open_flags( mode ), kDefaultPermissions ); // flawfinder: ignore
+    } while ( result < 0 && errno == EINTR );
+    return result;
+}
+
+constexpr auto kInvalidHandle = -1;
+
+/* On POSIX systems, the file is always opened as buffered, and the page cache is bypassed afterward:
+ * this way, if the filesystem doesn't support it (e.g., tmpfs), we can simply keep using the buffered file. */
+auto set_unbuffered( int fileDescriptor, bool unbuffered ) noexcept -> bool {
+#if defined( O_DIRECT )
+    const int flags = ::fcntl( fileDescriptor, F_GETFL );
+    if ( flags < 0 ) {
+        return false;
+    }
+    const int newFlags = unbuffered ? ( flags | O_DIRECT ) : ( flags & ~O_DIRECT );
+    return ::fcntl( fileDescriptor, F_SETFL, newFlags ) == 0;
+#elif defined( F_NOCACHE )
+    return ::fcntl( fileDescriptor, F_NOCACHE, unbuffered ? 1 : 0 ) != -1;
+#else
+    ( void )fileDescriptor;
+    return !unbuffered;
+#endif
+}
+#endif
+} // namespace
+
+FileHandle::FileHandle( const fs::path& filePath, FileOpenMode mode, bool unbuffered )
+    : mHandle{ open_file( filePath, mode, unbuffered ) }, mUnbuffered{ unbuffered } {
+#ifdef _WIN32
+    if ( mHandle == kInvalidHandle && unbuffered && ::GetLastError() == ERROR_INVALID_PARAMETER ) {
+        // Unbuffered access is not supported for the file, falling back to the buffered one.
+        mHandle = open_file( filePath, mode, false );
+        mUnbuffered = false;
+    }
+#endif
+    if ( mHandle == kInvalidHandle ) {
+        throw BitException( open_error_message( mode ), last_error_code(), path_to_tstring( filePath ) );
+    }
+#ifndef _WIN32
+    if ( unbuffered ) {
+        mUnbuffered = set_unbuffered( mHandle, true );
+    }
+#endif
+}
+
+FileHandle::~FileHandle() {
+#ifdef _WIN32
+    ::CloseHandle( mHandle );
+#else
+    ::close( mHandle );
+#endif
+}
+
+auto FileHandle::native() const noexcept -> native_handle_t {
+    return mHandle;
+}
+
+auto FileHandle::read( void* data, UInt32 size, uint64_t offset, UInt32& processedSize ) const noexcept -> HRESULT {
+    processedSize = 0;
+#ifdef _WIN32
+    OVERLAPPED overlapped = make_overlapped( offset );
+    DWORD readSize = 0;
+    if ( ::ReadFile( mHandle, data, size, &readSize, &overlapped ) == FALSE ) {
+        const DWORD error = ::GetLastError();
+        if ( error != ERROR_HANDLE_EOF ) { // Reading past the end of the file is not an error.
+            return HRESULT_FROM_WIN32( error );
+        }
+    }
+    processedSize = readSize;
+#else
+    ssize_t readSize{};
+    do {
+        readSize = ::pread( mHandle, data, size, static_cast< off_t >( offset ) ); // flawfinder: ignore
+    } while ( readSize < 0 && errno == EINTR );
+    if ( readSize < 0 ) {
+        return HRESULT_FROM_WIN32( GetLastError() );
+    }
+    processedSize = static_cast< UInt32 >( readSize );
+#endif
+    return S_OK;
+}
+
+auto FileHandle::write( const void* data,
+                        UInt32 size,
+                        uint64_t offset,
+                        UInt32& processedSize ) const noexcept -> HRESULT {
+    processedSize = 0;
+#ifdef _WIN32
+    OVERLAPPED overlapped = make_overlapped( offset );
+    DWORD writtenSize = 0;
+    if ( ::WriteFile( mHandle, data, size, &writtenSize, &overlapped ) == FALSE ) {
+        return HRESULT_FROM_WIN32( ::GetLastError() );
+    }
+    processedSize = writtenSize;
+#else
+    ssize_t writtenSize{};
+    do {
+        writtenSize = ::pwrite( mHandle, data, size, static_cast< off_t >( offset ) );
+    } while ( writtenSize < 0 && errno == EINTR );
+    if ( writtenSize < 0 ) {
+        return HRESULT_FROM_WIN32( GetLastError() );
+    }
+    processedSize = static_cast< UInt32 >( writtenSize );
+#endif
+    return S_OK;
+}
+
+auto FileHandle::size( uint64_t& fileSize ) const noexcept -> HRESULT {
+#ifdef _WIN32
+    LARGE_INTEGER result{};
+    if ( ::GetFileSizeEx( mHandle, &result ) == FALSE ) {
+        return HRESULT_FROM_WIN32( ::GetLastError() );
+    }
+    fileSize = static_cast< uint64_t >( result.QuadPart );
+#else
+    struct stat fileStat{};
+    if ( ::fstat( mHandle, &fileStat ) != 0 ) {
+        return HRESULT_FROM_WIN32( GetLastError() );
+    }
+    fileSize = static_cast< uint64_t >( fileStat.st_size );
+#endif
+    return S_OK;
+}
+
+auto FileHandle::resize( uint64_t newSize ) const noexcept -> HRESULT {
+#ifdef _WIN32
+    FILE_END_OF_FILE_INFO endOfFile{};
+    endOfFile.EndOfFile.QuadPart = static_cast< LONGLONG >( newSize );
+    if ( ::SetFileInformationByHandle( mHandle, FileEndOfFileInfo, &endOfFile, sizeof( endOfFile ) ) == FALSE ) {
+        return HRESULT_FROM_WIN32( ::GetLastError() );
+    }
+#else
+    if ( ::ftruncate( mHandle, static_cast< off_t >( newSize ) ) != 0 ) {
+        return HRESULT_FROM_WIN32( GetLastError() );
+    }
+#endif
+    return S_OK;
+}
+
+auto FileHandle::preallocate( uint64_t size ) const noexcept -> HRESULT {
+#if defined( _WIN32 )
+    FILE_ALLOCATION_INFO allocationInfo{};
+    allocationInfo.AllocationSize.QuadPart = static_cast< LONGLONG >( size );
+    const DWORD infoSize = sizeof( allocationInfo );
+    if ( ::SetFileInformationByHandle( mHandle, FileAllocationInfo, &allocationInfo, infoSize ) == FALSE ) {
+        return HRESULT_FROM_WIN32( ::GetLastError() );
+    }
+#elif defined( __linux__ )
+    int result{};
+    do {
+        result = ::fallocate( mHandle, FALLOC_FL_KEEP_SIZE, 0, static_cast< off_t >( size ) );
+    } while ( result != 0 && errno == EINTR );
+    if ( result != 0 ) {
+        return HRESULT_FROM_WIN32( GetLastError() );
+    }
+#elif defined( __APPLE__ )
+    fstore_t store{};
+    store.fst_flags = F_ALLOCATECONTIG | F_ALLOCATEALL;
+    store.fst_posmode = F_PEOFPOSMODE;
+    store.fst_length = static_cast< off_t >( size );
+    if ( ::fcntl( mHandle, F_PREALLOCATE, &store ) == -1 ) {
+        // Contiguous space is not available, trying to allocate non-contiguous space.
+        store.fst_flags = F_ALLOCATEALL;
+        if ( ::fcntl( mHandle, F_PREALLOCATE, &store ) == -1 ) {
+            return HRESULT_FROM_WIN32( GetLastError() );
+        }
+    }
+#else
+    // Note: we don't use posix_fallocate, since it would also change the size of the file.
+    ( void )size;
+    return E_NOTIMPL;
+#endif
+    return S_OK;
+}
+
+auto FileHandle::isUnbuffered() const noexcept -> bool {
+    return mUnbuffered;
+}
+
+auto FileHandle::disableUnbuffered() noexcept -> HRESULT {
+    if ( !mUnbuffered ) {
+        return S_OK;
+    }
+#ifdef _WIN32
+    // The buffering mode of a handle cannot be changed, so we reopen the file with a new (buffered) handle.
+    HANDLE bufferedHandle = ::ReOpenFile( mHandle, GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, 0 );
+    if ( bufferedHandle == INVALID_HANDLE_VALUE ) {
+        return HRESULT_FROM_WIN32( ::GetLastError() );
+    }
+    ::CloseHandle( mHandle );
+    mHandle = bufferedHandle;
+#else
+    if ( !set_unbuffered( mHandle, false ) ) {
+        return HRESULT_FROM_WIN32( GetLastError() );
+    }
+#endif
+    mUnbuffered = false;
+    return S_OK;
+}
+
+} // namespace bit7z
@@ -0,0 +1,85 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FILEHANDLE_HPP
+#define FILEHANDLE_HPP
+
+#include "bitdefines.hpp"
+#include "bittypes.hpp"
+#include "internal/fs.hpp"
+#include "internal/windows.hpp"
+
+#include <Common/MyTypes.h>
+
+namespace bit7z {
+
+#ifdef _WIN32
+using native_handle_t = HANDLE;
+#else
+using native_handle_t = int;
+#endif
+
+enum struct FileOpenMode {
+    Read,
+    CreateNew,
+    CreateAlways,
+    OpenExisting // Opens an existing file for writing, without truncating it.
+};
+
+/**
+ * A thin RAII wrapper over a native file handle (a file descriptor on POSIX systems),
+ * performing positional reads and writes without touching the file offset of the OS.
+ *
+ * If requested, the file is accessed bypassing the OS page cache (i.e., O_DIRECT on Linux, F_NOCACHE on macOS,
+ * and FILE_FLAG_NO_BUFFERING on Windows); when the filesystem doesn't support it, the handle silently falls back
+ * to the normal buffered access (see isUnbuffered()).
+ * Unbuffered reads and writes must use buffers, offsets, and sizes aligned to kUnbufferedAlignment.
+ */
+class FileHandle final {
+    public:
+        static constexpr std::size_t kUnbufferedAlignment = 4096;
+
+        FileHandle( const fs::path& filePath, FileOpenMode mode, bool unbuffered = false );
+
+        FileHandle( const FileHandle& ) = delete;
+
+        FileHandle( FileHandle&& ) = delete;
+
+        auto operator=( const FileHandle& ) -> FileHandle& = delete;
+
+        auto operator=( FileHandle&& ) -> FileHandle& = delete;
+
+        ~FileHandle();
+
+        BIT7Z_NODISCARD auto native() const noexcept -> native_handle_t;
+
+        auto read( void* data, UInt32 size, uint64_t offset, UInt32& processedSize ) const noexcept -> HRESULT;
+
+        auto write( const void* data, UInt32 size, uint64_t offset, UInt32& processedSize ) const noexcept -> HRESULT;
+
+        auto size( uint64_t& fileSize ) const noexcept -> HRESULT;
+
+        auto resize( uint64_t newSize ) const noexcept -> HRESULT;
+
+        // Reserves the disk space for the given file size, without changing the size of the file.
+        auto preallocate( uint64_t size ) const noexcept -> HRESULT;
+
+        BIT7Z_NODISCARD auto isUnbuffered() const noexcept -> bool;
+
+        // Switches the handle back to the normal (buffered) access, e.g., to write an unaligned tail.
+        auto disableUnbuffered() noexcept -> HRESULT;
+
+    private:
+        native_handle_t mHandle;
+        bool mUnbuffered;
+};
+
+}  // namespace bit7z
+
+#endif // FILEHANDLE_HPP
@@ -0,0 +1,35 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FILESTREAMS_HPP
+#define FILESTREAMS_HPP
+
+#ifdef BIT7Z_USE_STD_FILE_STREAMS
+#include "internal/cfileinstream.hpp"
+#include "internal/cfileoutstream.hpp"
+#else
+#include "internal/cnativefileinstream.hpp"
+#include "internal/cnativefileoutstream.hpp"
+#endif
+
+namespace bit7z {
+
+/* By default, files are read and written through native file handles;
+ * the std::fstream based streams are kept as a fallback, enabled via the BIT7Z_USE_STD_FILE_STREAMS option. */
+#ifdef BIT7Z_USE_STD_FILE_STREAMS
+using FileInStream = CFileInStream;
+using FileOutStream = CFileOutStream;
+#else
+using FileInStream = CNativeFileInStream;
+using FileOutStream = CNativeFileOutStream;
+#endif
+
+}  // namespace bit7z
+
+#endif // FILESTREAMS_HPP
@@ -10,6 +10,9 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 
+#include <algorithm>
+#include <utility>
+
 #include "internal/cfixedbufferoutstream.hpp"
 #include "internal/fixedbufferextractcallback.hpp"
 #include "internal/util.hpp"
@@ -17,9 +20,8 @@
 namespace bit7z {
 
 FixedBufferExtractCallback::FixedBufferExtractCallback( const BitInputArchive& inputArchive,
-                                                        byte_t* buffer,
-                                                        size_t size )
-    : ExtractCallback( inputArchive ), mBuffer( buffer ), mSize( size ) {}
+                                                        std::vector< ItemBuffer > itemBuffers )
+    : ExtractCallback( inputArchive ), mItemBuffers( std::move( itemBuffers ) ) {}
 
 void FixedBufferExtractCallback::releaseStream() {
     mOutMemStream.Release();
@@ -30,6 +32,14 @@ auto FixedBufferExtractCallback::getOutStream( uint32_t index, ISequentialOutStr
         return S_OK;
     }
 
+    const auto itemBuffer = std::lower_bound( mItemBuffers.cbegin(), mItemBuffers.cend(), index,
+                                              []( const ItemBuffer& target, uint32_t value ) -> bool {
+                                                  return target.index < value;
+                                              } );
+    if ( itemBuffer == mItemBuffers.cend() || itemBuffer->index != index ) {
+        return S_OK; // No output buffer for this item.
+    }
+
     // Get Name
     const BitPropVariant prop = itemProperty( index, BitProperty::Path );
     tstring fullPath;
@@ -46,7 +56,12 @@ auto FixedBufferExtractCallback::getOutStream( uint32_t index, ISequentialOutStr
         mHandler.fileCallback()( fullPath );
     }
 
-    auto outStreamLoc = bit7z::make_com< CFixedBufferOutStream, ISequentialOutStream >( mBuffer, mSize );
+    if ( itemBuffer->size == 0 ) {
+        return S_OK; // Nothing to be written for empty items (whose buffer might be null).
+    }
+
+    auto outStreamLoc = bit7z::make_com< CFixedBufferOutStream, ISequentialOutStream >( itemBuffer->buffer,
+                                                                                         itemBuffer->size );
     mOutMemStream = outStreamLoc;
     *outStream = outStreamLoc.Detach();
     return S_OK;
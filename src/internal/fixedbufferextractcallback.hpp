@@ -10,6 +10,8 @@
 #ifndef FIXEDBUFFEREXTRACTCALLBACK_HPP
 #define FIXEDBUFFEREXTRACTCALLBACK_HPP
 
+#include <vector>
+
 #include "bittypes.hpp"
 #include "internal/extractcallback.hpp"
 
@@ -17,7 +19,11 @@ namespace bit7z {
 
 class FixedBufferExtractCallback final : public ExtractCallback {
     public:
-        FixedBufferExtractCallback( const BitInputArchive& inputArchive, byte_t* buffer, size_t size );
+        /**
+         * @param inputArchive  the archive to be extracted.
+         * @param itemBuffers   the pre-allocated output buffers of the items to be extracted, sorted by item index.
+         */
+        FixedBufferExtractCallback( const BitInputArchive& inputArchive, std::vector< ItemBuffer > itemBuffers );
 
         FixedBufferExtractCallback( const FixedBufferExtractCallback& ) = delete;
 
@@ -30,8 +36,7 @@ class FixedBufferExtractCallback final : public ExtractCallback {
         ~FixedBufferExtractCallback() override = default;
 
     private:
-        byte_t* mBuffer;
-        size_t mSize;
+        std::vector< ItemBuffer > mItemBuffers;
         CMyComPtr< ISequentialOutStream > mOutMemStream;
 
         void releaseStream() override;
@@ -13,8 +13,8 @@
 #include <system_error>
 
 #include "bitexception.hpp"
-#include "internal/cfileinstream.hpp"
 #include "internal/csymlinkinstream.hpp"
+#include "internal/filestreams.hpp"
 #include "internal/fsitem.hpp"
 #include "internal/stringutil.hpp"
 #include "internal/util.hpp"
@@ -149,7 +149,7 @@ auto FilesystemItem::getStream( ISequentialInStream** inStream ) const -> HRESUL
     }
 
     try {
-        auto inStreamLoc = bit7z::make_com< CFileInStream >( filesystemPath() );
+        auto inStreamLoc = bit7z::make_com< FileInStream >( filesystemPath() );
         *inStream = inStreamLoc.Detach();
     } catch ( const BitException& ex ) {
         return ex.nativeCode();
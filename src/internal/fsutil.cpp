@@ -11,20 +11,14 @@
  */
 
 #include <algorithm> //for std::adjacent_find
+#include <array>
+#include <cwctype> // for iswdigit and towlower
 
 #ifndef _WIN32
-#include <sys/resource.h> // for rlimit, getrlimit, and setrlimit
 #include <sys/stat.h>
 #include <unistd.h>
 
 #include "internal/dateutil.hpp"
-
-// For some reason, GCC on macOS requires including <climits> for defining OPEN_MAX.
-#if defined( __APPLE__ ) && !defined( __clang__ )
-#include <climits>
-#endif
-#elif defined( BIT7Z_PATH_SANITIZATION )
-#include <cwctype> // for iswdigit
 #endif
 
 #include "internal/fsutil.hpp"
@@ -50,6 +44,14 @@ auto fsutil::extension( const fs::path& path ) -> tstring {
     return result.substr( 1 );
 }
 
+auto fsutil::case_folded_path( const fs::path& path ) -> std::wstring {
+    std::wstring result = path_to_wide_string( path );
+    std::transform( result.cbegin(), result.cend(), result.begin(), []( wchar_t character ) -> wchar_t {
+        return static_cast< wchar_t >( std::towlower( static_cast< std::wint_t >( character ) ) );
+    } );
+    return result;
+}
+
 inline auto contains_dot_references( const fs::path& path ) -> bool {
     return std::find_if( path.begin(), path.end(), [] ( const fs::path& component ) -> bool {
         return component == BIT7Z_NATIVE_STRING( "." ) || component == BIT7Z_NATIVE_STRING( ".." );
@@ -183,10 +185,12 @@ static const mode_t global_umask = []() noexcept -> mode_t {
 using stat_t = struct stat;
 const auto os_lstat = &lstat;
 const auto os_stat = &stat;
+const auto os_fstat = &fstat;
 #else
 using stat_t = struct stat64;
 const auto os_lstat = &lstat64;
 const auto os_stat = &stat64;
+const auto os_fstat = &fstat64;
 #endif
 #endif
 
@@ -227,6 +231,28 @@ auto fsutil::set_file_attributes( const fs::path& filePath, DWORD attributes ) n
 #endif
 }
 
+#ifndef _WIN32
+auto fsutil::set_file_attributes( int fileDescriptor, DWORD attributes ) noexcept -> bool {
+    stat_t fileStat{};
+    if ( os_fstat( fileDescriptor, &fileStat ) != 0 ) {
+        return false;
+    }
+
+    if ( ( attributes & FILE_ATTRIBUTE_UNIX_EXTENSION ) != 0 ) {
+        fileStat.st_mode = static_cast< mode_t >( attributes >> 16U );
+        if ( !S_ISREG( fileStat.st_mode ) ) { // E.g., symbolic links, which are restored by path.
+            return false;
+        }
+    } else if ( ( attributes & FILE_ATTRIBUTE_READONLY ) != 0 ) {
+        fileStat.st_mode &= static_cast< mode_t >( ~( S_IWUSR | S_IWGRP | S_IWOTH ) );
+    }
+
+    const auto filePermissions = static_cast< mode_t >( fileStat.st_mode & global_umask ) &
+                                 static_cast< mode_t >( fs::perms::mask );
+    return fchmod( fileDescriptor, filePermissions ) == 0;
+}
+#endif
+
 #ifdef _WIN32
 auto fsutil::set_file_time( const fs::path& filePath,
                             FILETIME creation,
@@ -245,11 +271,18 @@ auto fsutil::set_file_time( const fs::path& filePath,
                                  0,
                                  nullptr );
     if ( hFile != INVALID_HANDLE_VALUE ) { // NOLINT(cppcoreguidelines-pro-type-cstyle-cast,performance-no-int-to-ptr)
-        res = ::SetFileTime( hFile, &creation, &access, &modified ) != FALSE;
+        res = set_file_time( hFile, creation, access, modified );
         CloseHandle( hFile );
     }
     return res;
 }
+
+auto fsutil::set_file_time( HANDLE fileHandle,
+                            FILETIME creation,
+                            FILETIME access,
+                            FILETIME modified ) noexcept -> bool {
+    return ::SetFileTime( fileHandle, &creation, &access, &modified ) != FALSE;
+}
 #else
 auto fsutil::set_file_modified_time( const fs::path& filePath, FILETIME ftModified ) noexcept -> bool {
     if ( filePath.empty() ) {
@@ -261,6 +294,12 @@ auto fsutil::set_file_modified_time( const fs::path& filePath, FILETIME ftModifi
     fs::last_write_time( filePath, fileTime, error );
     return !error;
 }
+
+auto fsutil::set_file_modified_time( int fileDescriptor, FILETIME ftModified ) noexcept -> bool {
+    // Note: like fs::last_write_time, we leave the last access time unchanged.
+    const std::array< timespec, 2 > fileTimes{ { { 0, UTIME_OMIT }, FILETIME_to_timespec( ftModified ) } };
+    return futimens( fileDescriptor, fileTimes.data() ) == 0;
+}
 #endif
 
 auto fsutil::get_file_attributes_ex( const fs::path& filePath,
@@ -324,26 +363,6 @@ auto fsutil::format_long_path( const fs::path& path ) -> fs::path {
 
 #endif
 
-void fsutil::increase_opened_files_limit() {
-#if defined( _MSC_VER )
-    // http://msdn.microsoft.com/en-us/library/6e3b887c.aspx
-    _setmaxstdio( 8192 );
-#elif defined( __MINGW32__ )
-    // MinGW uses an older max value for this function
-    _setmaxstdio( 2048 );
-#else
-    rlimit limits{ 0, 0 };
-    if ( getrlimit( RLIMIT_NOFILE, &limits ) == 0 ) {
-#ifdef __APPLE__
-        limits.rlim_cur = std::min( static_cast< rlim_t >( OPEN_MAX ), limits.rlim_max );
-#else
-        limits.rlim_cur = limits.rlim_max;
-#endif
-        setrlimit( RLIMIT_NOFILE, &limits );
-    }
-#endif
-}
-
 #if defined( _WIN32 ) && defined( BIT7Z_PATH_SANITIZATION )
 inline auto is_windows_reserved_name( const std::wstring& component ) -> bool {
     // Reserved file names that can't be used on Windows: CON, PRN, AUX, and NUL.
@@ -31,6 +31,9 @@ BIT7Z_NODISCARD auto stem( const tstring& path ) -> tstring;
 
 BIT7Z_NODISCARD auto extension( const fs::path& path ) -> tstring;
 
+// Returns the lowercase version of the path, e.g., for comparing paths on case-insensitive filesystems.
+BIT7Z_NODISCARD auto case_folded_path( const fs::path& path ) -> std::wstring;
+
 // Note: wildcard_match is "semi-public", so we cannot pass the path as fs::path!
 BIT7Z_NODISCARD auto wildcard_match( const tstring& pattern, const tstring& path ) -> bool;
 
@@ -41,12 +44,22 @@ BIT7Z_NODISCARD auto get_file_attributes_ex( const fs::path& filePath,
 #ifdef _WIN32
 // TODO: In future, use std::optional instead of empty FILETIME objects.
 auto set_file_time( const fs::path& filePath, FILETIME creation, FILETIME access, FILETIME modified ) noexcept -> bool;
+
+// Note: the handle must have been opened with the FILE_WRITE_ATTRIBUTES access right (e.g., via GENERIC_WRITE).
+auto set_file_time( HANDLE fileHandle, FILETIME creation, FILETIME access, FILETIME modified ) noexcept -> bool;
 #else
 auto set_file_modified_time( const fs::path& filePath, FILETIME ftModified ) noexcept -> bool;
+
+auto set_file_modified_time( int fileDescriptor, FILETIME ftModified ) noexcept -> bool;
 #endif
 
 auto set_file_attributes( const fs::path& filePath, DWORD attributes ) noexcept -> bool;
 
+#ifndef _WIN32
+// Note: it fails for the items that can only be restored by path (e.g., symbolic links).
+auto set_file_attributes( int fileDescriptor, DWORD attributes ) noexcept -> bool;
+#endif
+
 BIT7Z_NODISCARD auto in_archive_path( const fs::path& filePath,
                                       const fs::path& searchPath = fs::path{} ) -> fs::path;
 
@@ -63,13 +76,6 @@ BIT7Z_NODISCARD auto format_long_path( const fs::path& path ) -> fs::path;
 #   define FORMAT_LONG_PATH( path ) path
 #endif
 
-/**
- * @brief When writing multi-volume archives, we keep all the volume streams open until we finished.
- * This is less than ideal, and there's a limit in the number of open file descriptors/handles.
- * This function is a temporary workaround, where we increase such a limit to the maximum value allowed by the OS.
- */
-void increase_opened_files_limit();
-
 #if defined( _WIN32 ) && defined( BIT7Z_PATH_SANITIZATION )
 /**
  * Sanitizes the given file path, removing any eventual Windows illegal character
@@ -64,6 +64,9 @@ const GUID IID_ISetProperties = {
 const GUID IID_IInArchive = {
     0x23170F69, 0x40C1, 0x278A, { 0x00, 0x00, 0x00, 0x06, 0x00, 0x60, 0x00, 0x00 }
 };
+const GUID IID_IInArchiveGetStream = {
+    0x23170F69, 0x40C1, 0x278A, { 0x00, 0x00, 0x00, 0x06, 0x00, 0x40, 0x00, 0x00 }
+};
 const GUID IID_IOutArchive = {
     0x23170F69, 0x40C1, 0x278A, { 0x00, 0x00, 0x00, 0x06, 0x00, 0xA0, 0x00, 0x00 }
 };
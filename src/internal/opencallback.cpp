@@ -11,7 +11,7 @@
  */
 
 #include "bitexception.hpp"
-#include "internal/cfileinstream.hpp"
+#include "internal/filestreams.hpp"
 #include "internal/opencallback.hpp"
 #include "internal/stringutil.hpp"
 #include "internal/util.hpp"
@@ -67,7 +67,7 @@ STDMETHODIMP OpenCallback::GetStream( const wchar_t* name, IInStream** inStream
         }
 
         try {
-            auto inStreamTemp = bit7z::make_com< CFileInStream >( streamPath );
+            auto inStreamTemp = bit7z::make_com< FileInStream >( streamPath );
             *inStream = inStreamTemp.Detach();
         } catch ( const BitException& ex ) {
             return ex.nativeCode();
@@ -0,0 +1,81 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "internal/parallelextractcontext.hpp"
+
+namespace bit7z {
+
+ParallelExtractContext::ParallelExtractContext( const BitAbstractArchiveHandler& handler, std::size_t workersCount )
+    : mHandler{ handler },
+      mWorkers( workersCount, WorkerProgress{ 0, 0, 0, 0 } ),
+      mOverall{ 0, 0, 0, 0 },
+      mAborted{ false } {}
+
+void ParallelExtractContext::setTotal( std::size_t worker, uint64_t total ) {
+    const std::lock_guard< std::mutex > lock{ mMutex };
+    // Workers report their totals independently, so the overall total grows until every worker has started.
+    mOverall.total = mOverall.total - mWorkers[ worker ].total + total;
+    mWorkers[ worker ].total = total;
+    if ( mHandler.totalCallback() ) {
+        mHandler.totalCallback()( mOverall.total );
+    }
+}
+
+auto ParallelExtractContext::setCompleted( std::size_t worker, uint64_t completed ) -> bool {
+    if ( aborted() ) {
+        return false;
+    }
+
+    const std::lock_guard< std::mutex > lock{ mMutex };
+    mOverall.completed = mOverall.completed - mWorkers[ worker ].completed + completed;
+    mWorkers[ worker ].completed = completed;
+    if ( mHandler.progressCallback() && !mHandler.progressCallback()( mOverall.completed ) ) {
+        mAborted = true;
+        return false;
+    }
+    return true;
+}
+
+void ParallelExtractContext::setRatioInfo( std::size_t worker, uint64_t inSize, uint64_t outSize ) {
+    const std::lock_guard< std::mutex > lock{ mMutex };
+    mOverall.inSize = mOverall.inSize - mWorkers[ worker ].inSize + inSize;
+    mOverall.outSize = mOverall.outSize - mWorkers[ worker ].outSize + outSize;
+    mWorkers[ worker ].inSize = inSize;
+    mWorkers[ worker ].outSize = outSize;
+    if ( mHandler.ratioCallback() ) {
+        mHandler.ratioCallback()( mOverall.inSize, mOverall.outSize );
+    }
+}
+
+auto ParallelExtractContext::lockCallbacks() -> std::unique_lock< std::mutex > {
+    return std::unique_lock< std::mutex >{ mMutex };
+}
+
+void ParallelExtractContext::abort( const std::exception_ptr& error ) noexcept {
+    const std::lock_guard< std::mutex > lock{ mMutex };
+    // Only the first error is kept: the following ones are usually caused by the workers being aborted.
+    if ( !mError ) {
+        mError = error;
+    }
+    mAborted = true;
+}
+
+auto ParallelExtractContext::aborted() const noexcept -> bool {
+    return mAborted;
+}
+
+auto ParallelExtractContext::error() const noexcept -> std::exception_ptr {
+    // Note: the error is read only after all the workers have finished, so no locking is needed.
+    return mError;
+}
+
+} // namespace bit7z
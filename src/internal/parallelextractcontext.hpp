@@ -0,0 +1,66 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PARALLELEXTRACTCONTEXT_HPP
+#define PARALLELEXTRACTCONTEXT_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+#include "bitabstractarchivehandler.hpp"
+
+namespace bit7z {
+
+/**
+ * @brief The state shared by the workers of a parallel extraction.
+ *
+ * Each worker extracts a subset of the items through its own decoder instance: the context aggregates the
+ * progress reported by the workers, serializes the calls to the user callbacks of the archive handler,
+ * and lets a failing worker stop the other ones.
+ */
+class ParallelExtractContext final {
+    public:
+        ParallelExtractContext( const BitAbstractArchiveHandler& handler, std::size_t workersCount );
+
+        void setTotal( std::size_t worker, uint64_t total );
+
+        BIT7Z_NODISCARD auto setCompleted( std::size_t worker, uint64_t completed ) -> bool;
+
+        void setRatioInfo( std::size_t worker, uint64_t inSize, uint64_t outSize );
+
+        BIT7Z_NODISCARD auto lockCallbacks() -> std::unique_lock< std::mutex >;
+
+        void abort( const std::exception_ptr& error ) noexcept;
+
+        BIT7Z_NODISCARD auto aborted() const noexcept -> bool;
+
+        BIT7Z_NODISCARD auto error() const noexcept -> std::exception_ptr;
+
+    private:
+        struct WorkerProgress {
+            uint64_t total;
+            uint64_t completed;
+            uint64_t inSize;
+            uint64_t outSize;
+        };
+
+        const BitAbstractArchiveHandler& mHandler;
+        std::mutex mMutex;
+        std::vector< WorkerProgress > mWorkers;
+        WorkerProgress mOverall;
+        std::atomic< bool > mAborted;
+        std::exception_ptr mError;
+};
+
+}  // namespace bit7z
+
+#endif // PARALLELEXTRACTCONTEXT_HPP
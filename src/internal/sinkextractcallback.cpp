@@ -0,0 +1,76 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "internal/csinkoutstream.hpp"
+#include "internal/sinkextractcallback.hpp"
+#include "internal/util.hpp"
+
+namespace bit7z {
+
+SinkExtractCallback::SinkExtractCallback( const BitInputArchive& inputArchive, const ExtractSink& sink )
+    : ExtractCallback( inputArchive ), mSink( sink ), mCurrentIndex( 0 ), mItemStarted( false ) {}
+
+void SinkExtractCallback::releaseStream() {
+    mSinkOutStream.Release();
+}
+
+auto SinkExtractCallback::getOutStream( uint32_t index, ISequentialOutStream** outStream ) -> HRESULT {
+    if ( isItemFolder( index ) ) {
+        return S_OK;
+    }
+
+    if ( mHandler.fileCallback() ) {
+        // The path is needed only by the file callback, so we avoid retrieving it when it is not set.
+        const BitPropVariant prop = itemProperty( index, BitProperty::Path );
+        if ( prop.isEmpty() ) {
+            mHandler.fileCallback()( kEmptyFileAlias );
+        } else if ( prop.isString() ) {
+            mHandler.fileCallback()( prop.getString() );
+        } else {
+            return E_FAIL;
+        }
+    }
+
+    if ( mSink.onItemBegin ) {
+        try {
+            mSink.onItemBegin( index );
+        } catch ( ... ) {
+            mSinkException = std::current_exception();
+            return E_ABORT;
+        }
+    }
+    mCurrentIndex = index;
+    mItemStarted = true;
+
+    auto outStreamLoc = bit7z::make_com< CSinkOutStream, ISequentialOutStream >( mSink.onData, index, mSinkException );
+    mSinkOutStream = outStreamLoc;
+    *outStream = outStreamLoc.Detach();
+    return S_OK;
+}
+
+auto SinkExtractCallback::finishOperation( OperationResult operationResult ) -> HRESULT {
+    const HRESULT result = ExtractCallback::finishOperation( operationResult );
+    if ( mItemStarted ) {
+        mItemStarted = false;
+        if ( mSink.onItemEnd ) {
+            try {
+                mSink.onItemEnd( mCurrentIndex, operationResult == OperationResult::Success );
+            } catch ( ... ) {
+                mSinkException = std::current_exception();
+                return E_ABORT;
+            }
+        }
+    }
+    return result;
+}
+
+} // namespace bit7z
@@ -0,0 +1,55 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef SINKEXTRACTCALLBACK_HPP
+#define SINKEXTRACTCALLBACK_HPP
+
+#include "internal/extractcallback.hpp"
+
+namespace bit7z {
+
+class SinkExtractCallback final : public ExtractCallback {
+    public:
+        SinkExtractCallback( const BitInputArchive& inputArchive, const ExtractSink& sink );
+
+        SinkExtractCallback( const SinkExtractCallback& ) = delete;
+
+        SinkExtractCallback( SinkExtractCallback&& ) = delete;
+
+        auto operator=( const SinkExtractCallback& ) -> SinkExtractCallback& = delete;
+
+        auto operator=( SinkExtractCallback&& ) -> SinkExtractCallback& = delete;
+
+        ~SinkExtractCallback() override = default;
+
+        /**
+         * @return the exception thrown by the sink's callbacks, if any (a null pointer otherwise).
+         */
+        BIT7Z_NODISCARD
+        inline auto sinkException() const noexcept -> const std::exception_ptr& {
+            return mSinkException;
+        }
+
+    private:
+        const ExtractSink& mSink;
+        CMyComPtr< ISequentialOutStream > mSinkOutStream;
+        uint32_t mCurrentIndex;
+        bool mItemStarted;
+        std::exception_ptr mSinkException;
+
+        void releaseStream() override;
+
+        auto getOutStream( uint32_t index, ISequentialOutStream** outStream ) -> HRESULT override;
+
+        auto finishOperation( OperationResult operationResult ) -> HRESULT override;
+};
+
+}  // namespace bit7z
+
+#endif // SINKEXTRACTCALLBACK_HPP
@@ -10,7 +10,7 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 
-#include "internal/cfileoutstream.hpp"
+#include "internal/filestreams.hpp"
 #include "internal/updatecallback.hpp"
 #include "internal/stringutil.hpp"
 #include "internal/util.hpp"
@@ -106,7 +106,7 @@ STDMETHODIMP UpdateCallback::GetVolumeStream( UInt32 index, ISequentialOutStream
     const tstring fileName = BIT7Z_STRING( '.' ) + res;// + mVolExt;
 
     try {
-        auto stream = bit7z::make_com< CFileOutStream >( fileName );
+        auto stream = bit7z::make_com< FileOutStream >( fileName );
         *volumeStream = stream.Detach();
     } catch ( const BitException& ex ) {
         return ex.nativeCode();
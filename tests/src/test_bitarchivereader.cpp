@@ -274,6 +274,108 @@ TEMPLATE_TEST_CASE( "BitArchiveReader: Reading archives containing multiple item
     }
 }
 
+TEST_CASE( "BitArchiveReader: Querying the items of an archive", "[bitarchivereader]" ) {
+    static const TestDirectory testDir{ fs::path{ test_archives_dir } / "extraction" / "multiple_items" };
+
+    const Bit7zLibrary lib{ test::sevenzip_lib_path() };
+
+    const auto testArchive = GENERATE( as< MultipleItemsArchive >(),
+                                       MultipleItemsArchive{ "7z", BitFormat::SevenZip, 563797 },
+                                       MultipleItemsArchive{ "tar", BitFormat::Tar, 617472 },
+                                       MultipleItemsArchive{ "zip", BitFormat::Zip, 564097 } );
+
+    DYNAMIC_SECTION( "Archive format: " << testArchive.extension() ) {
+        const fs::path arcFileName = "multiple_items." + testArchive.extension();
+        BitArchiveReader info( lib, path_to_tstring( arcFileName ), testArchive.format() );
+
+        SECTION( "Reading only the requested item properties" ) {
+            const auto availableProperties = info.availableItemProperties();
+            REQUIRE_FALSE( availableProperties.empty() );
+
+            const std::vector< BitProperty > properties{ BitProperty::Path, BitProperty::Size, BitProperty::IsDir };
+            const auto columns = info.itemsProperties( properties );
+            REQUIRE( columns.size() == properties.size() );
+
+            const auto items = info.items();
+            for ( std::size_t column = 0; column < properties.size(); ++column ) {
+                REQUIRE( columns[ column ].size() == items.size() );
+                for ( const auto& item : items ) {
+                    REQUIRE( columns[ column ][ item.index() ] == item.itemProperty( properties[ column ] ) );
+                }
+            }
+
+            REQUIRE( info.itemsProperties( {} ).empty() );
+        }
+
+        SECTION( "Building a compact catalog of the archive items" ) {
+            const BitArchiveCatalog catalog{ info };
+            REQUIRE( catalog.itemsCount() == info.itemsCount() );
+            for ( const auto& item : info ) {
+                const auto index = item.index();
+                REQUIRE( catalog.path( index ) == item.path() );
+                REQUIRE( catalog.name( index ) == item.name() );
+                REQUIRE( catalog.isDir( index ) == item.isDir() );
+                REQUIRE( catalog.isEncrypted( index ) == item.isEncrypted() );
+                REQUIRE( catalog.size( index ) == item.size() );
+                REQUIRE( catalog.packSize( index ) == item.packSize() );
+                REQUIRE( catalog.crc( index ) == item.crc() );
+                REQUIRE( catalog.attributes( index ) == item.attributes() );
+                if ( item.itemProperty( BitProperty::MTime ).isFileTime() ) {
+                    REQUIRE( catalog.lastWriteTime( index ) == item.lastWriteTime() );
+                }
+            }
+            REQUIRE_THROWS_AS( catalog.path( info.itemsCount() ), BitException );
+            REQUIRE_THROWS_AS( catalog.size( info.itemsCount() ), BitException );
+            REQUIRE_THROWS_AS( catalog.lastWriteTime( info.itemsCount() ), BitException );
+        }
+
+        SECTION( "Finding the archive items by path" ) {
+            // Looking up the items twice, so that the second lookups use the already built index.
+            for ( int pass = 0; pass < 2; ++pass ) {
+                for ( const auto& item : info ) {
+                    const auto iterator = info.find( item.path() );
+                    REQUIRE( iterator != info.cend() );
+                    REQUIRE( iterator->index() == item.index() );
+                    REQUIRE( info.contains( item.path() ) );
+                }
+                REQUIRE( info.find( BIT7Z_STRING( "non_existing_item" ) ) == info.cend() );
+                REQUIRE_FALSE( info.contains( BIT7Z_STRING( "non_existing_item" ) ) );
+            }
+
+            REQUIRE( info.contains( BIT7Z_STRING( "folder/clouds.jpg" ) ) );
+#ifdef _WIN32
+            const auto iterator = info.find( BIT7Z_STRING( "folder/clouds.jpg" ) );
+            REQUIRE( iterator == info.find( BIT7Z_STRING( "folder\\clouds.jpg" ) ) );
+#endif
+        }
+
+        SECTION( "Computing the summary of the archive items" ) {
+            const auto summary = info.summary();
+            const auto& archiveContent = testArchive.content();
+            REQUIRE( summary.filesCount == archiveContent.fileCount );
+            REQUIRE( summary.foldersCount == archiveContent.items.size() - archiveContent.fileCount );
+            REQUIRE( summary.size == archiveContent.size );
+            REQUIRE( summary.packSize == testArchive.packedSize() );
+            REQUIRE_FALSE( summary.hasEncryptedItems );
+            REQUIRE_FALSE( summary.isEncrypted );
+
+            REQUIRE( info.foldersCount() == summary.foldersCount );
+            REQUIRE( info.filesCount() == summary.filesCount );
+            REQUIRE( info.size() == summary.size );
+            REQUIRE( info.packSize() == summary.packSize );
+            REQUIRE( info.hasEncryptedItems() == summary.hasEncryptedItems );
+            REQUIRE( info.isEncrypted() == summary.isEncrypted );
+
+            info.invalidateSummary();
+            const auto recomputedSummary = info.summary();
+            REQUIRE( recomputedSummary.foldersCount == summary.foldersCount );
+            REQUIRE( recomputedSummary.filesCount == summary.filesCount );
+            REQUIRE( recomputedSummary.size == summary.size );
+            REQUIRE( recomputedSummary.packSize == summary.packSize );
+        }
+    }
+}
+
 struct EncryptedArchive : public TestInputArchive {
     EncryptedArchive( std::string extension, const BitInFormat& format, std::size_t packedSize )
         : TestInputArchive{ std::move( extension ), format, packedSize, encrypted_content() } {}
@@ -581,6 +683,10 @@ TEMPLATE_TEST_CASE( "BitArchiveReader: Checking consistency between items() and
         for ( const auto& iteratedItem : info ) {
             const auto& archivedItem = archiveItems[ iteratedItem.index() ];
             REQUIRE_ITEM_EQUAL( archivedItem, iteratedItem );
+            REQUIRE( archivedItem.itemProperty( BitProperty::Path ) == iteratedItem.itemProperty( BitProperty::Path ) );
+            for ( const auto& property : archivedItem.itemProperties() ) {
+                REQUIRE( property.second == iteratedItem.itemProperty( property.first ) );
+            }
         }
     }
 }
@@ -12,15 +12,455 @@
 
 #include <catch2/catch.hpp>
 
+#include <algorithm>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+#include "utils/content.hpp"
+#include "utils/filesystem.hpp"
+#include "utils/format.hpp"
 #include "utils/shared_lib.hpp"
 
+#include <bit7z/bitarchivereader.hpp>
+#include <bit7z/bitarchivewriter.hpp>
+#include <bit7z/bitfilecompressor.hpp>
 #include <bit7z/bitfileextractor.hpp>
+#include <internal/stringutil.hpp>
 
 using namespace bit7z;
+using namespace bit7z::test;
+using namespace bit7z::test::filesystem;
 
 TEST_CASE( "BitFileExtractor: TODO", "[bitfileextractor]" ) {
     const Bit7zLibrary lib{ test::sevenzip_lib_path() };
 
     const BitFileExtractor extractor{lib, BitFormat::SevenZip};
     REQUIRE( extractor.extractionFormat() == BitFormat::SevenZip ); // Just a placeholder test.
-}
\ No newline at end of file
+}
+
+TEST_CASE( "BitFileExtractor: Extracting a single file archive", "[bitfileextractor]" ) {
+    static const TestDirectory testDir{ fs::path{ test_archives_dir } / "extraction" / "single_file" };
+
+    const Bit7zLibrary lib{ test::sevenzip_lib_path() };
+
+    const auto testArchive = GENERATE( as< TestInputFormat >(),
+                                       TestInputFormat{ "7z", BitFormat::SevenZip },
+                                       TestInputFormat{ "tar", BitFormat::Tar },
+                                       TestInputFormat{ "zip", BitFormat::Zip } );
+
+    DYNAMIC_SECTION( "Archive format: " << testArchive.extension ) {
+        const auto arcFileName = fs::path{ clouds.name }.concat( "." + testArchive.extension );
+
+        BitFileExtractor extractor{ lib, testArchive.format };
+        REQUIRE( extractor.fileAccessMode() == FileAccessMode::Stream );
+
+        std::map< tstring, buffer_t > expectedContent;
+        REQUIRE_NOTHROW( extractor.extract( path_to_tstring( arcFileName ), expectedContent ) );
+        REQUIRE( expectedContent.size() == 1 );
+
+        SECTION( "Using memory-mapped input files" ) {
+            const auto hint = GENERATE( AccessPatternHint::Normal,
+                                        AccessPatternHint::Sequential,
+                                        AccessPatternHint::Random );
+            extractor.setFileAccessMode( FileAccessMode::MemoryMapped );
+            extractor.setAccessPatternHint( hint );
+            REQUIRE( extractor.fileAccessMode() == FileAccessMode::MemoryMapped );
+            REQUIRE( extractor.accessPatternHint() == hint );
+
+            std::map< tstring, buffer_t > mappedContent;
+            REQUIRE_NOTHROW( extractor.extract( path_to_tstring( arcFileName ), mappedContent ) );
+            REQUIRE( mappedContent == expectedContent );
+            REQUIRE_NOTHROW( extractor.test( path_to_tstring( arcFileName ) ) );
+        }
+
+        SECTION( "Extracting byte ranges of the item" ) {
+            const BitArchiveReader reader{ lib, path_to_tstring( arcFileName ), testArchive.format };
+            const buffer_t& content = expectedContent.begin()->second;
+            REQUIRE( content.size() == clouds.size );
+
+            const uint64_t offset = GENERATE( 0u, 1u, 4096u, 100000u );
+            const std::size_t length = GENERATE( 0u, 16u, 65536u, 10000000u );
+
+            buffer_t range{ 1, 2, 3 };
+            REQUIRE_NOTHROW( reader.extractRange( 0, offset, length, range ) );
+
+            const auto rangeBegin = static_cast< std::size_t >( std::min< uint64_t >( offset, content.size() ) );
+            const auto rangeEnd = std::min( rangeBegin + length, content.size() );
+            REQUIRE( range == buffer_t( content.data() + rangeBegin, content.data() + rangeEnd ) );
+
+            // Ranges larger than the item must not allocate more memory than the item's size.
+            REQUIRE_NOTHROW( reader.extractRange( 0, offset, std::numeric_limits< std::size_t >::max(), range ) );
+            REQUIRE( range == buffer_t( content.data() + rangeBegin, content.data() + content.size() ) );
+
+            REQUIRE_THROWS_AS( reader.extractRange( 1, 0, 16, range ), BitException );
+        }
+    }
+}
+
+TEST_CASE( "BitFileExtractor: Extracting an archive with multiple items", "[bitfileextractor]" ) {
+    static const TestDirectory testDir{ fs::path{ test_archives_dir } / "extraction" / "multiple_items" };
+
+    const Bit7zLibrary lib{ test::sevenzip_lib_path() };
+
+    const auto testArchive = GENERATE( as< TestInputFormat >(),
+                                       TestInputFormat{ "7z", BitFormat::SevenZip },
+                                       TestInputFormat{ "zip", BitFormat::Zip } );
+
+    DYNAMIC_SECTION( "Archive format: " << testArchive.extension ) {
+        const auto arcFileName = fs::path{ "multiple_items" }.concat( "." + testArchive.extension );
+
+        BitFileExtractor extractor{ lib, testArchive.format };
+        const BitArchiveReader reader{ lib, path_to_tstring( arcFileName ), testArchive.format };
+
+        std::map< tstring, buffer_t > expectedContent;
+        REQUIRE_NOTHROW( extractor.extract( path_to_tstring( arcFileName ), expectedContent ) );
+
+        SECTION( "Using multiple decoding and writer threads" ) {
+            const fs::path outDir = unique_temp_path( "bit7z_parallel_extraction" );
+
+            REQUIRE( extractor.extractionThreads() == 1 );
+            const std::size_t threadsCount = GENERATE( 1u, 2u, 4u, 64u );
+            extractor.setExtractionThreads( threadsCount );
+            REQUIRE( extractor.extractionThreads() == threadsCount );
+
+            REQUIRE( extractor.extractionWriterThreads() == 0 );
+            const std::size_t writerThreads = GENERATE( 0u, 1u, 3u );
+            extractor.setExtractionWriterThreads( writerThreads );
+            REQUIRE( extractor.extractionWriterThreads() == writerThreads );
+
+            uint64_t lastProgress = 0;
+            extractor.setProgressCallback( [ &lastProgress ]( uint64_t progress ) -> bool {
+                lastProgress = progress;
+                return true;
+            } );
+            REQUIRE_NOTHROW( extractor.extract( path_to_tstring( arcFileName ), path_to_tstring( outDir ) ) );
+
+            for ( const auto& item : multiple_items_content().items ) {
+                const auto itemPath = outDir / item.inArchivePath;
+                if ( item.fileInfo.isDir ) {
+                    REQUIRE( fs::is_directory( itemPath ) );
+                } else {
+                    REQUIRE( load_file( itemPath ) == expectedContent[ path_to_tstring( item.inArchivePath ) ] );
+                }
+            }
+            REQUIRE( lastProgress > 0 );
+            fs::remove_all( outDir );
+        }
+
+        SECTION( "Extracting to a sink" ) {
+            std::map< uint32_t, buffer_t > sinkContent;
+            std::vector< uint32_t > endedItems;
+            bool outsideItem = true;
+            ExtractSink sink;
+            sink.onItemBegin = [ &sinkContent, &outsideItem ]( uint32_t index ) {
+                outsideItem = false;
+                sinkContent[ index ];
+            };
+            sink.onData = [ &sinkContent, &outsideItem ]( uint32_t index,
+                                                          const byte_t* data,
+                                                          std::size_t size ) -> bool {
+                REQUIRE_FALSE( outsideItem );
+                auto& content = sinkContent[ index ];
+                content.insert( content.end(), data, data + size );
+                return true;
+            };
+            sink.onItemEnd = [ &endedItems, &outsideItem ]( uint32_t index, bool success ) {
+                REQUIRE( success );
+                outsideItem = true;
+                endedItems.push_back( index );
+            };
+            REQUIRE_NOTHROW( extractor.extract( path_to_tstring( arcFileName ), sink ) );
+
+            REQUIRE( sinkContent.size() == expectedContent.size() );
+            REQUIRE( endedItems.size() == expectedContent.size() );
+            for ( const auto& item : sinkContent ) {
+                const auto& expected = expectedContent.find( reader.itemAt( item.first ).path() );
+                REQUIRE( expected != expectedContent.end() );
+                REQUIRE( item.second == expected->second );
+            }
+
+            // Returning false from the data callback stops the extraction.
+            sink.onData = []( uint32_t, const byte_t*, std::size_t ) -> bool {
+                return false;
+            };
+            REQUIRE_THROWS( extractor.extract( path_to_tstring( arcFileName ), sink ) );
+
+            // The exceptions thrown by the callbacks are propagated to the caller.
+            sink.onItemBegin = nullptr;
+            sink.onItemEnd = nullptr;
+            sink.onData = []( uint32_t, const byte_t*, std::size_t ) -> bool {
+                throw std::invalid_argument( "Invalid data" );
+            };
+            REQUIRE_THROWS_AS( extractor.extract( path_to_tstring( arcFileName ), sink ), std::invalid_argument );
+
+            sink.onData = []( uint32_t, const byte_t*, std::size_t ) -> bool {
+                throw std::bad_alloc();
+            };
+            REQUIRE_THROWS_AS( extractor.extract( path_to_tstring( arcFileName ), sink ), std::bad_alloc );
+
+            sink.onData = []( uint32_t, const byte_t*, std::size_t ) -> bool {
+                return true;
+            };
+            sink.onItemBegin = []( uint32_t ) {
+                throw std::invalid_argument( "Invalid item" );
+            };
+            REQUIRE_THROWS_AS( extractor.extract( path_to_tstring( arcFileName ), sink ), std::invalid_argument );
+
+            sink.onItemBegin = nullptr;
+            sink.onItemEnd = []( uint32_t, bool ) {
+                throw std::invalid_argument( "Invalid item" );
+            };
+            REQUIRE_THROWS_AS( extractor.extract( path_to_tstring( arcFileName ), sink ), std::invalid_argument );
+
+            sink.onItemEnd = nullptr;
+            sink.onData = nullptr;
+            REQUIRE_THROWS_AS( extractor.extract( path_to_tstring( arcFileName ), sink ), BitException );
+        }
+
+        SECTION( "Extracting to a single memory arena" ) {
+            BitExtractedData extractedData;
+            REQUIRE_NOTHROW( extractor.extract( path_to_tstring( arcFileName ), extractedData ) );
+            REQUIRE( extractedData.size() == expectedContent.size() );
+
+            std::size_t position = 0;
+            for ( const auto& expected : expectedContent ) {
+                REQUIRE( extractedData.path( position ) == expected.first );
+                REQUIRE( extractedData.find( expected.first ) == position );
+                REQUIRE( extractedData.contains( expected.first ) );
+
+                const buffer_t content( extractedData.data( position ),
+                                        extractedData.data( position ) + extractedData.dataSize( position ) );
+                REQUIRE( content == expected.second );
+                ++position;
+            }
+            REQUIRE_FALSE( extractedData.contains( BIT7Z_STRING( "non_existing_file.txt" ) ) );
+            REQUIRE( extractedData.find( BIT7Z_STRING( "non_existing_file.txt" ) ) == extractedData.size() );
+
+            extractedData.clear();
+            REQUIRE( extractedData.empty() );
+            REQUIRE( extractedData.arena().empty() );
+        }
+
+        SECTION( "Extracting to pre-allocated buffers" ) {
+            // Buffers are given in reverse index order, to check that they are correctly matched to their items.
+            std::vector< buffer_t > buffers;
+            std::vector< ItemBuffer > itemBuffers;
+            buffers.reserve( reader.itemsCount() );
+            for ( uint32_t index = reader.itemsCount(); index > 0; --index ) {
+                const auto item = reader.itemAt( index - 1 );
+                if ( item.isDir() ) {
+                    continue;
+                }
+                buffers.emplace_back( static_cast< std::size_t >( item.size() ) );
+                // Empty items need no buffer.
+                byte_t* buffer = item.size() == 0 ? nullptr : buffers.back().data();
+                itemBuffers.push_back( { item.index(), buffer, buffers.back().size() } );
+            }
+            REQUIRE_FALSE( itemBuffers.empty() );
+            REQUIRE_NOTHROW( extractor.extract( path_to_tstring( arcFileName ), itemBuffers ) );
+
+            for ( std::size_t i = 0; i < itemBuffers.size(); ++i ) {
+                REQUIRE( buffers[ i ] == expectedContent[ reader.itemAt( itemBuffers[ i ].index ).path() ] );
+            }
+
+            itemBuffers.push_back( itemBuffers.front() );
+            REQUIRE_THROWS_AS( extractor.extract( path_to_tstring( arcFileName ), itemBuffers ), BitException );
+
+            itemBuffers.back().size += 1;
+            REQUIRE_THROWS_AS( extractor.extract( path_to_tstring( arcFileName ), itemBuffers ), BitException );
+        }
+
+        SECTION( "Extracting multiple items to memory in a single pass" ) {
+            std::vector< uint32_t > indices;
+            for ( const auto& item : reader ) {
+                if ( !item.isDir() ) {
+                    indices.insert( indices.begin(), item.index() ); // Unsorted indices must be supported.
+                }
+            }
+
+            std::map< tstring, buffer_t > itemsContent;
+            REQUIRE_NOTHROW( extractor.extractItems( path_to_tstring( arcFileName ), indices, itemsContent ) );
+            REQUIRE( itemsContent == expectedContent );
+
+            std::map< tstring, buffer_t > matchingContent;
+            REQUIRE_NOTHROW( extractor.extractMatching( path_to_tstring( arcFileName ),
+                                                        BIT7Z_STRING( "*" ),
+                                                        matchingContent ) );
+            REQUIRE( matchingContent == expectedContent );
+
+            std::map< tstring, buffer_t > excludedContent;
+            REQUIRE_THROWS_AS( extractor.extractMatching( path_to_tstring( arcFileName ),
+                                                          BIT7Z_STRING( "*" ),
+                                                          excludedContent,
+                                                          FilterPolicy::Exclude ), BitException );
+            REQUIRE( excludedContent.empty() );
+        }
+    }
+}
+
+TEST_CASE( "BitFileExtractor: Extracting a multi-block solid archive using multiple threads", "[bitfileextractor]" ) {
+    const Bit7zLibrary lib{ test::sevenzip_lib_path() };
+
+    const fs::path testDir = unique_temp_path( "bit7z_solid_extraction" );
+    REQUIRE( fs::create_directories( testDir / "input" ) );
+
+    // Six files with different sizes and contents, stored in three solid blocks of two files each.
+    constexpr uint32_t filesCount = 6;
+    std::map< tstring, buffer_t > expectedContent;
+    std::map< tstring, tstring > inputFiles;
+    for ( uint32_t file = 0; file < filesCount; ++file ) {
+        const auto fileName = "file" + std::to_string( file ) + ".bin";
+        buffer_t content = make_content( 10000 * ( file + 1 ) + file );
+        std::rotate( content.begin(), content.begin() + file * 7, content.end() );
+
+        const fs::path filePath = testDir / "input" / fileName;
+        fs::ofstream outFile{ filePath, std::ios::binary };
+        outFile.write( reinterpret_cast< const char* >( content.data() ), // NOLINT(*-reinterpret-cast)
+                       static_cast< std::streamsize >( content.size() ) );
+        outFile.close();
+
+        inputFiles[ path_to_tstring( filePath ) ] = path_to_tstring( fs::path{ fileName } );
+        expectedContent[ path_to_tstring( fs::path{ fileName } ) ] = std::move( content );
+    }
+
+    const fs::path arcFileName = testDir / "solid.7z";
+    BitFileCompressor compressor{ lib, BitFormat::SevenZip };
+    compressor.setSolidMode( true );
+    compressor.setFormatProperty( L"s", std::wstring{ L"2f" } );
+    REQUIRE_NOTHROW( compressor.compress( inputFiles, path_to_tstring( arcFileName ) ) );
+
+    const BitArchiveReader reader{ lib, path_to_tstring( arcFileName ), BitFormat::SevenZip };
+    REQUIRE( reader.isSolid() );
+    REQUIRE( reader.archiveProperty( BitProperty::NumBlocks ).getUInt64() == filesCount / 2 );
+
+    std::map< uint64_t, std::size_t > blocksItems;
+    for ( const auto& item : reader ) {
+        const BitPropVariant block = item.itemProperty( BitProperty::Block );
+        REQUIRE( block.isUInt64() );
+        ++blocksItems[ block.getUInt64() ];
+    }
+    REQUIRE( blocksItems.size() == filesCount / 2 );
+    for ( const auto& block : blocksItems ) {
+        REQUIRE( block.second == 2 );
+    }
+
+    // Using more threads than solid blocks: the threads count is capped to the number of blocks.
+    const std::size_t threadsCount = GENERATE( 1u, 2u, 3u, 8u );
+    const std::size_t writerThreads = GENERATE( 0u, 2u );
+
+    DYNAMIC_SECTION( "Threads: " << threadsCount << ", writer threads: " << writerThreads ) {
+        BitFileExtractor extractor{ lib, BitFormat::SevenZip };
+        extractor.setExtractionThreads( threadsCount );
+        extractor.setExtractionWriterThreads( writerThreads );
+
+        const fs::path outDir = testDir / "output";
+        fs::remove_all( outDir );
+        REQUIRE_NOTHROW( extractor.extract( path_to_tstring( arcFileName ), path_to_tstring( outDir ) ) );
+
+        for ( const auto& expected : expectedContent ) {
+            REQUIRE( load_file( outDir / tstring_to_path( expected.first ) ) == expected.second );
+        }
+    }
+
+    std::error_code error;
+    fs::remove_all( testDir, error );
+}
+
+TEST_CASE( "BitFileExtractor: Extracting an archive with duplicate paths using multiple threads",
+           "[bitfileextractor]" ) {
+    const Bit7zLibrary lib{ test::sevenzip_lib_path() };
+
+    const fs::path testDir = unique_temp_path( "bit7z_duplicate_paths_extraction" );
+    REQUIRE( fs::create_directories( testDir ) );
+
+    /* A tar archive containing multiple versions of the same file, interleaved with other files:
+     * extracting it must always give the last version of the file, as in a sequential extraction. */
+    constexpr uint32_t filesCount = 8;
+    std::vector< buffer_t > contents;
+    contents.reserve( filesCount ); // Note: the writer keeps a view of the contents, so they must not be moved.
+    std::map< tstring, buffer_t > expectedContent;
+    BitArchiveWriter writer{ lib, BitFormat::Tar };
+    for ( uint32_t file = 0; file < filesCount; ++file ) {
+        buffer_t content = make_content( 10000 * ( file + 1 ) + file );
+        std::rotate( content.begin(), content.begin() + file * 7, content.end() );
+        contents.push_back( std::move( content ) );
+
+        const auto fileName = file % 2 == 0 ? std::string{ "duplicate.bin" } :
+                              "file" + std::to_string( file ) + ".bin";
+        writer.addFile( contents.back(), path_to_tstring( fs::path{ fileName } ) );
+        expectedContent[ path_to_tstring( fs::path{ fileName } ) ] = contents.back();
+    }
+    const fs::path arcFileName = testDir / "duplicates.tar";
+    REQUIRE_NOTHROW( writer.compressTo( path_to_tstring( arcFileName ) ) );
+
+    const BitArchiveReader reader{ lib, path_to_tstring( arcFileName ), BitFormat::Tar };
+    REQUIRE( reader.itemsCount() == filesCount );
+
+    // Multiple writer threads must also write the versions of the same file in order.
+    const std::size_t threadsCount = GENERATE( 1u, 2u, 4u );
+    const std::size_t writerThreads = GENERATE( 0u, 1u, 3u, 8u );
+
+    DYNAMIC_SECTION( "Threads: " << threadsCount << ", writer threads: " << writerThreads ) {
+        BitFileExtractor extractor{ lib, BitFormat::Tar };
+        extractor.setOverwriteMode( OverwriteMode::Overwrite );
+        extractor.setExtractionThreads( threadsCount );
+        extractor.setExtractionWriterThreads( writerThreads );
+
+        const fs::path outDir = testDir / "output";
+        fs::remove_all( outDir );
+        REQUIRE_NOTHROW( extractor.extract( path_to_tstring( arcFileName ), path_to_tstring( outDir ) ) );
+
+        for ( const auto& expected : expectedContent ) {
+            REQUIRE( load_file( outDir / tstring_to_path( expected.first ) ) == expected.second );
+        }
+    }
+
+    std::error_code error;
+    fs::remove_all( testDir, error );
+}
+
+TEST_CASE( "BitFileExtractor: Extracting empty items to pre-allocated buffers", "[bitfileextractor]" ) {
+    const Bit7zLibrary lib{ test::sevenzip_lib_path() };
+
+    const fs::path testDir = unique_temp_path( "bit7z_empty_items_extraction" );
+    REQUIRE( fs::create_directories( testDir ) );
+
+    const buffer_t emptyContent{};
+    const buffer_t content = make_content( 1000 );
+    BitArchiveWriter writer{ lib, BitFormat::SevenZip };
+    writer.addFile( emptyContent, BIT7Z_STRING( "empty.bin" ) );
+    writer.addFile( content, BIT7Z_STRING( "content.bin" ) );
+    const fs::path arcFileName = testDir / "empty_items.7z";
+    REQUIRE_NOTHROW( writer.compressTo( path_to_tstring( arcFileName ) ) );
+
+    const BitArchiveReader reader{ lib, path_to_tstring( arcFileName ), BitFormat::SevenZip };
+    REQUIRE( reader.itemsCount() == 2 );
+    const auto emptyItem = reader.find( BIT7Z_STRING( "empty.bin" ) );
+    const auto contentItem = reader.find( BIT7Z_STRING( "content.bin" ) );
+    REQUIRE( emptyItem != reader.cend() );
+    REQUIRE( contentItem != reader.cend() );
+    REQUIRE( emptyItem->size() == 0 );
+
+    const BitFileExtractor extractor{ lib, BitFormat::SevenZip };
+    buffer_t extractedContent( content.size() );
+    byte_t unusedByte = 0;
+
+    // Empty items can be extracted both to a null buffer and to a non-null one (which is left untouched).
+    byte_t* emptyItemBuffer = GENERATE( true, false ) ? nullptr : &unusedByte;
+    std::vector< ItemBuffer > itemBuffers{
+        ItemBuffer{ emptyItem->index(), emptyItemBuffer, 0 },
+        ItemBuffer{ contentItem->index(), extractedContent.data(), extractedContent.size() }
+    };
+    REQUIRE_NOTHROW( extractor.extract( path_to_tstring( arcFileName ), itemBuffers ) );
+    REQUIRE( extractedContent == content );
+    REQUIRE( unusedByte == 0 );
+
+    // A null buffer is not valid for non-empty items.
+    itemBuffers.back().buffer = nullptr;
+    REQUIRE_THROWS_AS( extractor.extract( path_to_tstring( arcFileName ), itemBuffers ), BitException );
+
+    std::error_code error;
+    fs::remove_all( testDir, error );
+}
@@ -0,0 +1,90 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <internal/bufferpool.hpp>
+#include <internal/filehandle.hpp>
+
+#include <cstdint>
+#include <set>
+#include <utility>
+#include <vector>
+
+using bit7z::BufferPool;
+using bit7z::FileHandle;
+using bit7z::PooledBuffer;
+
+TEST_CASE( "BufferPool: Buffer sizes depend on the file sizes", "[bufferpool]" ) {
+    REQUIRE( BufferPool::bufferSizeFor( 0 ) == BufferPool::kMinBufferSize );
+    REQUIRE( BufferPool::bufferSizeFor( 1 ) == BufferPool::kMinBufferSize );
+    REQUIRE( BufferPool::bufferSizeFor( 4096 ) == 4096 );
+    REQUIRE( BufferPool::bufferSizeFor( 4097 ) == 16 * 1024 );
+    REQUIRE( BufferPool::bufferSizeFor( 100 * 1024 ) == 256 * 1024 );
+    REQUIRE( BufferPool::bufferSizeFor( BufferPool::kMaxBufferSize ) == BufferPool::kMaxBufferSize );
+    REQUIRE( BufferPool::bufferSizeFor( UINT64_MAX ) == BufferPool::kMaxBufferSize );
+}
+
+TEST_CASE( "BufferPool: Acquiring and releasing buffers", "[bufferpool]" ) {
+    const std::size_t requestedSize = GENERATE( 1, 4096, 5000, 64 * 1024, 1024 * 1024, 8 * 1024 * 1024 );
+
+    const bit7z::byte_t* firstData = nullptr;
+    {
+        PooledBuffer buffer = BufferPool::acquire( requestedSize );
+        REQUIRE_FALSE( buffer.empty() );
+        REQUIRE( buffer.size() == BufferPool::bufferSizeFor( requestedSize ) );
+        firstData = buffer.data();
+
+        PooledBuffer movedBuffer = std::move( buffer );
+        REQUIRE( buffer.empty() ); // NOLINT(bugprone-use-after-move,hicpp-invalid-access-moved)
+        REQUIRE( movedBuffer.data() == firstData );
+    }
+
+    // The released buffer is reused by the next acquisition of the same size class in the same thread.
+    PooledBuffer buffer = BufferPool::acquire( requestedSize );
+    REQUIRE( buffer.data() == firstData );
+
+    buffer.reset();
+    REQUIRE( buffer.empty() );
+    REQUIRE( buffer.size() == 0 );
+}
+
+TEST_CASE( "BufferPool: Acquiring buffers for unbuffered I/O", "[bufferpool]" ) {
+    const std::size_t requestedSize = GENERATE( 1, 5000, 1024 * 1024 );
+
+    // Cached buffers that are not aligned must not be reused for unbuffered I/O.
+    BufferPool::acquire( requestedSize ).reset();
+
+    PooledBuffer buffer = BufferPool::acquireAligned( requestedSize );
+    REQUIRE( buffer.size() == BufferPool::bufferSizeFor( requestedSize ) );
+    REQUIRE( reinterpret_cast< std::uintptr_t >( buffer.data() ) % FileHandle::kUnbufferedAlignment == 0 );
+}
+
+TEST_CASE( "BufferPool: The buffers cached by a thread are bounded by size", "[bufferpool]" ) {
+    constexpr std::size_t kBuffersCount = ( BufferPool::kMaxCachedBytes / BufferPool::kMaxBufferSize ) + 2;
+
+    std::vector< PooledBuffer > buffers;
+    std::set< const bit7z::byte_t* > releasedData;
+    for ( std::size_t index = 0; index < kBuffersCount; ++index ) {
+        buffers.push_back( BufferPool::acquire( BufferPool::kMaxBufferSize ) );
+        releasedData.insert( buffers.back().data() );
+    }
+    buffers.clear();
+
+    std::size_t reusedCount = 0;
+    for ( std::size_t index = 0; index < kBuffersCount; ++index ) {
+        buffers.push_back( BufferPool::acquire( BufferPool::kMaxBufferSize ) );
+        reusedCount += releasedData.count( buffers.back().data() );
+    }
+    REQUIRE( reusedCount > 0 );
+    REQUIRE( reusedCount * BufferPool::kMaxBufferSize <= BufferPool::kMaxCachedBytes );
+}
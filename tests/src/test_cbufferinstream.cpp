@@ -353,4 +353,27 @@ TEST_CASE( "CBufferInStream: Reading a buffer stream", "[cbufferinstream][readin
         REQUIRE( processedSize == 0 ); // but we didn't read anything, as expected!
         REQUIRE( result == static_cast< byte_t >( 'A' ) ); // And hence, the result value was not changed!
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE( "CBufferInStream: Reading a non-owned memory region", "[cbufferinstream][reading]" ) {
+    const char message[] = "Hello World!"; // NOLINT(*-avoid-c-arrays)
+    const auto* data = reinterpret_cast< const byte_t* >( message ); // NOLINT(*-reinterpret-cast)
+
+    // Viewing only the "World" part of the message.
+    CBufferInStream inStream{ bit7z::BufferView{ data + 6, 5 } };
+
+    UInt64 newPosition{ 0 };
+    REQUIRE( inStream.Seek( 0, STREAM_SEEK_END, &newPosition ) == S_OK );
+    REQUIRE( newPosition == 5 );
+    REQUIRE( inStream.Seek( 1, STREAM_SEEK_END, &newPosition ) == E_INVALIDARG );
+    REQUIRE( inStream.Seek( 0, STREAM_SEEK_SET, &newPosition ) == S_OK );
+
+    buffer_t result( 16, static_cast< byte_t >( 0 ) );
+    UInt32 processedSize{ 0 };
+    REQUIRE( inStream.Read( &result[ 0 ], static_cast< UInt32 >( result.size() ), &processedSize ) == S_OK );
+    REQUIRE( processedSize == 5 );
+    REQUIRE( std::memcmp( result.data(), "World", processedSize ) == 0 );
+
+    REQUIRE( inStream.Read( &result[ 0 ], static_cast< UInt32 >( result.size() ), &processedSize ) == S_OK );
+    REQUIRE( processedSize == 0 );
+}
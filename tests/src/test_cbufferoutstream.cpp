@@ -0,0 +1,80 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <internal/cbufferoutstream.hpp>
+
+#include <string>
+
+using bit7z::byte_t;
+using bit7z::buffer_t;
+using bit7z::CBufferOutStream;
+
+namespace {
+auto as_bytes( const std::string& text ) -> buffer_t {
+    return { text.cbegin(), text.cend() };
+}
+} // namespace
+
+TEST_CASE( "CBufferOutStream: Writing to a buffer stream", "[cbufferoutstream][writing]" ) {
+    buffer_t buffer;
+    CBufferOutStream outStream{ buffer };
+    UInt32 processedSize = 0;
+    UInt64 newPosition = 0;
+
+    const buffer_t hello = as_bytes( "Hello World!" );
+    REQUIRE( outStream.Write( hello.data(), static_cast< UInt32 >( hello.size() ), &processedSize ) == S_OK );
+    REQUIRE( processedSize == hello.size() );
+    REQUIRE( buffer == hello );
+
+    SECTION( "Appending at the end of the buffer" ) {
+        const buffer_t data = as_bytes( " Bye!" );
+        REQUIRE( outStream.Write( data.data(), static_cast< UInt32 >( data.size() ), &processedSize ) == S_OK );
+        REQUIRE( processedSize == data.size() );
+        REQUIRE( buffer == as_bytes( "Hello World! Bye!" ) );
+    }
+
+    SECTION( "Overwriting part of the buffer after seeking backward" ) {
+        REQUIRE( outStream.Seek( 6, STREAM_SEEK_SET, &newPosition ) == S_OK );
+        REQUIRE( newPosition == 6 );
+
+        const buffer_t data = as_bytes( "bit7z" );
+        REQUIRE( outStream.Write( data.data(), static_cast< UInt32 >( data.size() ), &processedSize ) == S_OK );
+        REQUIRE( processedSize == data.size() );
+        REQUIRE( buffer == as_bytes( "Hello bit7z!" ) );
+
+        REQUIRE( outStream.Seek( 0, STREAM_SEEK_CUR, &newPosition ) == S_OK );
+        REQUIRE( newPosition == 11 );
+    }
+
+    SECTION( "Overwriting the tail of the buffer and appending the remaining data" ) {
+        REQUIRE( outStream.Seek( -6, STREAM_SEEK_END, &newPosition ) == S_OK );
+        REQUIRE( newPosition == 6 );
+
+        const buffer_t data = as_bytes( "everyone!" );
+        REQUIRE( outStream.Write( data.data(), static_cast< UInt32 >( data.size() ), &processedSize ) == S_OK );
+        REQUIRE( processedSize == data.size() );
+        REQUIRE( buffer == as_bytes( "Hello everyone!" ) );
+
+        // The stream position must be valid after the buffer has been reallocated.
+        const buffer_t tail = as_bytes( "!!" );
+        REQUIRE( outStream.Write( tail.data(), static_cast< UInt32 >( tail.size() ), &processedSize ) == S_OK );
+        REQUIRE( buffer == as_bytes( "Hello everyone!!!" ) );
+    }
+
+    SECTION( "Writing nothing to the stream" ) {
+        REQUIRE( outStream.Write( hello.data(), 0, &processedSize ) == E_FAIL );
+        REQUIRE( processedSize == 0 );
+        REQUIRE( buffer == hello );
+    }
+}
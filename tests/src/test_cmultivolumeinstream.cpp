@@ -0,0 +1,118 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <internal/cmultivolumeinstream.hpp>
+
+#include <algorithm>
+#include <string>
+
+#include "utils/content.hpp"
+#include "utils/filesystem.hpp"
+
+using bit7z::buffer_t;
+using bit7z::CMultiVolumeInStream;
+using bit7z::test::make_content;
+using bit7z::test::filesystem::unique_temp_path;
+
+namespace {
+constexpr std::size_t kVolumeSize = 1000;
+
+void write_volume( const fs::path& volumesDir, const buffer_t& content, std::size_t volumeNumber ) {
+    std::string extension = std::to_string( volumeNumber );
+    extension.insert( 0, 3 - extension.size(), '0' );
+    fs::ofstream volume{ volumesDir / ( "archive." + extension ), std::ios::binary };
+    REQUIRE( volume.is_open() );
+    const std::size_t volumeOffset = ( volumeNumber - 1 ) * kVolumeSize;
+    const std::size_t volumeSize = std::min( kVolumeSize, content.size() - volumeOffset );
+    // NOLINTNEXTLINE(*-pro-type-reinterpret-cast)
+    volume.write( reinterpret_cast< const char* >( &content[ volumeOffset ] ),
+                  static_cast< std::streamsize >( volumeSize ) );
+}
+
+auto read_at( CMultiVolumeInStream& inStream, UInt64 position, std::size_t size ) -> buffer_t {
+    UInt64 newPosition = 0;
+    REQUIRE( inStream.Seek( static_cast< Int64 >( position ), STREAM_SEEK_SET, &newPosition ) == S_OK );
+    REQUIRE( newPosition == position );
+
+    buffer_t result( size );
+    std::size_t readSize = 0;
+    while ( readSize < size ) {
+        UInt32 processedSize = 0;
+        const auto readRequest = static_cast< UInt32 >( size - readSize );
+        REQUIRE( inStream.Read( &result[ readSize ], readRequest, &processedSize ) == S_OK );
+        if ( processedSize == 0 ) {
+            break;
+        }
+        readSize += processedSize;
+    }
+    result.resize( readSize );
+    return result;
+}
+} // namespace
+
+TEST_CASE( "CMultiVolumeInStream: Reading and seeking across many volumes", "[cmultivolumeinstream]" ) {
+    // More volumes than the ones kept open at the same time by the stream (i.e., 8).
+    constexpr std::size_t volumesCount = 20;
+    const buffer_t content = make_content( volumesCount * kVolumeSize - 123 );
+
+    const fs::path volumesDir = unique_temp_path( "bit7z_multivolume" );
+    REQUIRE( fs::create_directories( volumesDir ) );
+    for ( std::size_t volume = 1; volume <= volumesCount; ++volume ) {
+        write_volume( volumesDir, content, volume );
+    }
+
+    {
+        CMultiVolumeInStream inStream{ volumesDir / "archive.001" };
+
+        // Reading the whole content sequentially, with reads crossing the volumes' boundaries.
+        REQUIRE( read_at( inStream, 0, content.size() + 1 ) == content );
+
+        // Reading again from the first volumes, whose files have been closed while reading the last ones.
+        for ( const std::size_t position : { 0u, 1500u, 999u, 19000u, 10u, 7999u, 12345u } ) {
+            const std::size_t size = std::min< std::size_t >( 2500, content.size() - position );
+            const buffer_t expected( content.cbegin() + static_cast< std::ptrdiff_t >( position ),
+                                     content.cbegin() + static_cast< std::ptrdiff_t >( position + size ) );
+            REQUIRE( read_at( inStream, position, size ) == expected );
+        }
+
+        UInt64 newPosition = 0;
+        REQUIRE( inStream.Seek( 0, STREAM_SEEK_END, &newPosition ) == S_OK );
+        REQUIRE( newPosition == content.size() );
+    }
+
+    std::error_code error;
+    fs::remove_all( volumesDir, error );
+}
+
+TEST_CASE( "CMultiVolumeInStream: Volumes are found lazily", "[cmultivolumeinstream]" ) {
+    const buffer_t content = make_content( 3 * kVolumeSize );
+
+    const fs::path volumesDir = unique_temp_path( "bit7z_lazy_multivolume" );
+    REQUIRE( fs::create_directories( volumesDir ) );
+    write_volume( volumesDir, content, 1 );
+
+    {
+        CMultiVolumeInStream inStream{ volumesDir / "archive.001" };
+        REQUIRE( read_at( inStream, 0, kVolumeSize / 2 ) == buffer_t( content.cbegin(),
+                                                                      content.cbegin() + kVolumeSize / 2 ) );
+
+        // The following volumes are looked for only when the stream reaches them.
+        write_volume( volumesDir, content, 2 );
+        write_volume( volumesDir, content, 3 );
+        REQUIRE( read_at( inStream, 0, content.size() ) == content );
+    }
+
+    std::error_code error;
+    fs::remove_all( volumesDir, error );
+}
@@ -0,0 +1,80 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <internal/cmultivolumeoutstream.hpp>
+#include <internal/util.hpp>
+
+#include <algorithm>
+#include <string>
+
+#include "utils/content.hpp"
+#include "utils/filesystem.hpp"
+
+using bit7z::buffer_t;
+using bit7z::byte_t;
+using bit7z::CMultiVolumeOutStream;
+using bit7z::test::make_content;
+using bit7z::test::filesystem::load_file;
+using bit7z::test::filesystem::unique_temp_path;
+
+TEST_CASE( "CMultiVolumeOutStream: Writing volumes and rewriting a closed one", "[cmultivolumeoutstream]" ) {
+    constexpr std::size_t volumeSize = 100;
+    constexpr std::size_t volumesCount = 10;
+    buffer_t content = make_content( volumesCount * volumeSize - 30 );
+
+    const fs::path volumesDir = unique_temp_path( "bit7z_multivolume_out" );
+    REQUIRE( fs::create_directories( volumesDir ) );
+
+    {
+        auto outStream = bit7z::make_com< CMultiVolumeOutStream >( volumeSize, volumesDir / "archive" );
+
+        // Writing in chunks that cross the volumes' boundaries.
+        constexpr std::size_t chunkSize = 64;
+        for ( std::size_t offset = 0; offset < content.size(); offset += chunkSize ) {
+            const auto writeSize = static_cast< UInt32 >( std::min( chunkSize, content.size() - offset ) );
+            UInt32 processedSize = 0;
+            while ( processedSize < writeSize ) {
+                UInt32 written = 0;
+                REQUIRE( outStream->Write( &content[ offset + processedSize ], writeSize - processedSize, &written )
+                         == S_OK );
+                REQUIRE( written > 0 );
+                processedSize += written;
+            }
+        }
+
+        // Going back to the first volume (already closed), like 7-Zip does for updating the archive's header.
+        const buffer_t header( 20, static_cast< byte_t >( 0xFF ) );
+        UInt64 newPosition = 0;
+        REQUIRE( outStream->Seek( 10, STREAM_SEEK_SET, &newPosition ) == S_OK );
+        REQUIRE( newPosition == 10 );
+        UInt32 processedSize = 0;
+        REQUIRE( outStream->Write( header.data(), static_cast< UInt32 >( header.size() ), &processedSize ) == S_OK );
+        REQUIRE( processedSize == header.size() );
+        std::copy( header.cbegin(), header.cend(), content.begin() + 10 );
+    }
+
+    buffer_t result;
+    for ( std::size_t volume = 1; volume <= volumesCount; ++volume ) {
+        std::string extension = std::to_string( volume );
+        extension.insert( 0, 3 - extension.size(), '0' );
+        const fs::path volumePath = volumesDir / ( "archive." + extension );
+        REQUIRE( fs::file_size( volumePath ) == std::min( volumeSize, content.size() - result.size() ) );
+        const buffer_t volumeContent = load_file( volumePath );
+        result.insert( result.end(), volumeContent.cbegin(), volumeContent.cend() );
+    }
+    REQUIRE( result == content );
+
+    std::error_code error;
+    fs::remove_all( volumesDir, error );
+}
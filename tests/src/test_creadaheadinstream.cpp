@@ -0,0 +1,85 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <internal/cbufferinstream.hpp>
+#include <internal/creadaheadinstream.hpp>
+#include <internal/util.hpp>
+
+#include <algorithm>
+
+#include "utils/content.hpp"
+
+using bit7z::buffer_t;
+using bit7z::CBufferInStream;
+using bit7z::CReadAheadInStream;
+using bit7z::test::make_content;
+
+TEST_CASE( "CReadAheadInStream: Reading sequentially a stream", "[creadaheadinstream]" ) {
+    const std::size_t contentSize = GENERATE( 0, 1, 1000, 4096, 10000 );
+    const std::size_t windowSize = GENERATE( 1, 512, 4096, 1024 * 1024 );
+    const UInt32 readSize = GENERATE( 1u, 100u, 4096u, 65536u );
+
+    DYNAMIC_SECTION( "Content size: " << contentSize << ", window size: " << windowSize
+                                      << ", read size: " << readSize ) {
+        const buffer_t content = make_content( contentSize );
+        auto bufferStream = bit7z::make_com< CBufferInStream, IInStream >( content );
+        CReadAheadInStream inStream{ bufferStream, windowSize };
+
+        buffer_t result;
+        buffer_t chunk( readSize );
+        UInt32 processedSize = 0;
+        do {
+            REQUIRE( inStream.Read( chunk.data(), readSize, &processedSize ) == S_OK );
+            REQUIRE( processedSize <= readSize );
+            result.insert( result.end(), chunk.cbegin(), chunk.cbegin() + processedSize );
+        } while ( processedSize > 0 );
+        REQUIRE( result == content );
+    }
+}
+
+TEST_CASE( "CReadAheadInStream: Seeking and reading a stream", "[creadaheadinstream]" ) {
+    const buffer_t content = make_content( 10000 );
+    auto bufferStream = bit7z::make_com< CBufferInStream, IInStream >( content );
+    CReadAheadInStream inStream{ bufferStream, 1024 };
+
+    UInt64 newPosition = 0;
+    REQUIRE( inStream.Seek( 0, STREAM_SEEK_END, &newPosition ) == S_OK );
+    REQUIRE( newPosition == content.size() );
+
+    buffer_t chunk( 100 );
+    UInt32 processedSize = 0;
+    REQUIRE( inStream.Read( chunk.data(), 100, &processedSize ) == S_OK );
+    REQUIRE( processedSize == 0 );
+
+    REQUIRE( inStream.Seek( -50, STREAM_SEEK_END, &newPosition ) == S_OK );
+    REQUIRE( newPosition == content.size() - 50 );
+    REQUIRE( inStream.Read( chunk.data(), 100, &processedSize ) == S_OK );
+    REQUIRE( processedSize == 50 );
+    REQUIRE( std::equal( chunk.cbegin(), chunk.cbegin() + 50, content.cend() - 50 ) );
+
+    const Int64 offset = GENERATE( 0, 1, 1000, 1023, 1024, 1025, 5000, 9999 );
+    DYNAMIC_SECTION( "Seeking to offset " << offset ) {
+        REQUIRE( inStream.Seek( offset, STREAM_SEEK_SET, &newPosition ) == S_OK );
+        REQUIRE( newPosition == static_cast< UInt64 >( offset ) );
+        REQUIRE( inStream.Read( chunk.data(), 100, &processedSize ) == S_OK );
+        REQUIRE( processedSize == ( std::min )( 100u, static_cast< UInt32 >( content.size() - static_cast< std::size_t >( offset ) ) ) );
+        REQUIRE( std::equal( chunk.cbegin(), chunk.cbegin() + processedSize, content.cbegin() + offset ) );
+
+        REQUIRE( inStream.Seek( -static_cast< Int64 >( processedSize ), STREAM_SEEK_CUR, &newPosition ) == S_OK );
+        REQUIRE( newPosition == static_cast< UInt64 >( offset ) );
+    }
+
+    REQUIRE( inStream.Seek( -1, STREAM_SEEK_SET, &newPosition ) == HRESULT_WIN32_ERROR_NEGATIVE_SEEK );
+    REQUIRE( inStream.Seek( 0, 3, &newPosition ) == STG_E_INVALIDFUNCTION );
+}
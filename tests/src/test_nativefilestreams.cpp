@@ -0,0 +1,276 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <bit7z/bitexception.hpp>
+#include <internal/cnativefileinstream.hpp>
+#include <internal/cnativefileoutstream.hpp>
+#include <internal/cunbufferedfileoutstream.hpp>
+
+#include <algorithm>
+
+#include "utils/content.hpp"
+#include "utils/filesystem.hpp"
+
+using bit7z::BitException;
+using bit7z::buffer_t;
+using bit7z::byte_t;
+using bit7z::CNativeFileInStream;
+using bit7z::CNativeFileOutStream;
+using bit7z::CUnbufferedFileOutStream;
+using bit7z::test::make_content;
+using bit7z::test::filesystem::unique_temp_path;
+
+TEST_CASE( "CNativeFileOutStream: Writing, seeking and resizing a file", "[nativefilestreams]" ) {
+    const fs::path filePath = unique_temp_path( "bit7z_native_out_stream" );
+    const buffer_t content = make_content( 4096 );
+    const auto contentSize = static_cast< UInt32 >( content.size() );
+
+    {
+        CNativeFileOutStream outStream{ filePath, true };
+        REQUIRE( outStream.path() == filePath );
+
+        UInt32 processedSize = 0;
+        REQUIRE( outStream.Write( content.data(), contentSize, &processedSize ) == S_OK );
+        REQUIRE( processedSize == contentSize );
+        REQUIRE_FALSE( outStream.fail() );
+
+        UInt64 newPosition = 0;
+        REQUIRE( outStream.Seek( 0, STREAM_SEEK_CUR, &newPosition ) == S_OK );
+        REQUIRE( newPosition == contentSize );
+
+        REQUIRE( outStream.Seek( 0, STREAM_SEEK_END, &newPosition ) == S_OK );
+        REQUIRE( newPosition == contentSize );
+
+        REQUIRE( outStream.Seek( -1, STREAM_SEEK_SET, &newPosition ) == HRESULT_WIN32_ERROR_NEGATIVE_SEEK );
+        REQUIRE( newPosition == contentSize );
+
+        // Overwriting the first bytes of the file.
+        const buffer_t header( 16, static_cast< byte_t >( 0xFF ) );
+        REQUIRE( outStream.Seek( 0, STREAM_SEEK_SET, &newPosition ) == S_OK );
+        REQUIRE( newPosition == 0 );
+        REQUIRE( outStream.Write( header.data(), static_cast< UInt32 >( header.size() ), &processedSize ) == S_OK );
+        REQUIRE( processedSize == header.size() );
+
+        REQUIRE( outStream.SetSize( contentSize * 2 ) == S_OK );
+        REQUIRE( outStream.Seek( 0, STREAM_SEEK_END, &newPosition ) == S_OK );
+        REQUIRE( newPosition == contentSize * 2 );
+    }
+
+    REQUIRE( fs::file_size( filePath ) == content.size() * 2 );
+
+    SECTION( "Creating a new file over an existing one should fail" ) {
+        REQUIRE_THROWS_AS( CNativeFileOutStream( filePath ), BitException );
+    }
+
+    SECTION( "Reading back the written file" ) {
+        CNativeFileInStream inStream{ filePath };
+        REQUIRE( inStream.fileSize() == content.size() * 2 );
+
+        buffer_t readContent( content.size() );
+        UInt32 processedSize = 0;
+        REQUIRE( inStream.Read( readContent.data(), contentSize, &processedSize ) == S_OK );
+        REQUIRE( processedSize == contentSize );
+        REQUIRE( std::all_of( readContent.cbegin(), readContent.cbegin() + 16, []( byte_t value ) {
+            return value == static_cast< byte_t >( 0xFF );
+        } ) );
+        REQUIRE( std::equal( readContent.cbegin() + 16, readContent.cend(), content.cbegin() + 16 ) );
+
+        // The extended part of the file must be zero-filled.
+        REQUIRE( inStream.Read( readContent.data(), contentSize, &processedSize ) == S_OK );
+        REQUIRE( processedSize == contentSize );
+        REQUIRE( std::all_of( readContent.cbegin(), readContent.cend(), []( byte_t value ) {
+            return value == static_cast< byte_t >( 0 );
+        } ) );
+
+        // Reading at the end of the file.
+        REQUIRE( inStream.Read( readContent.data(), contentSize, &processedSize ) == S_OK );
+        REQUIRE( processedSize == 0 );
+
+        UInt64 newPosition = 0;
+        REQUIRE( inStream.Seek( 100, STREAM_SEEK_SET, &newPosition ) == S_OK );
+        REQUIRE( newPosition == 100 );
+        REQUIRE( inStream.Read( readContent.data(), 10, &processedSize ) == S_OK );
+        REQUIRE( processedSize == 10 );
+        REQUIRE( std::equal( readContent.cbegin(), readContent.cbegin() + 10, content.cbegin() + 100 ) );
+
+        REQUIRE( inStream.Seek( -10, STREAM_SEEK_END, &newPosition ) == S_OK );
+        REQUIRE( newPosition == inStream.fileSize() - 10 );
+        REQUIRE( inStream.Read( readContent.data(), contentSize, &processedSize ) == S_OK );
+        REQUIRE( processedSize == 10 );
+
+        // Seeking past the end of the file is allowed, but reading gives no data.
+        REQUIRE( inStream.Seek( 10, STREAM_SEEK_END, &newPosition ) == S_OK );
+        REQUIRE( newPosition == inStream.fileSize() + 10 );
+        REQUIRE( inStream.Read( readContent.data(), contentSize, &processedSize ) == S_OK );
+        REQUIRE( processedSize == 0 );
+
+        REQUIRE( inStream.Seek( 0, 3, &newPosition ) == STG_E_INVALIDFUNCTION );
+    }
+
+    std::error_code error;
+    fs::remove( filePath, error );
+}
+
+TEST_CASE( "CNativeFileOutStream: Preallocating a file", "[nativefilestreams]" ) {
+    const fs::path filePath = unique_temp_path( "bit7z_preallocated_out_stream" );
+    const buffer_t content = make_content( 10000 );
+
+    {
+        CNativeFileOutStream outStream{ filePath, true };
+
+        // Preallocation is only a hint (it might not be supported by the filesystem), but it must never
+        // change the size of the file.
+        static_cast< void >( outStream.preallocate( 1024 * 1024 ) );
+
+        UInt64 newPosition = 0;
+        REQUIRE( outStream.Seek( 0, STREAM_SEEK_END, &newPosition ) == S_OK );
+        REQUIRE( newPosition == 0 );
+
+        UInt32 processedSize = 0;
+        REQUIRE( outStream.Write( content.data(), static_cast< UInt32 >( content.size() ), &processedSize ) == S_OK );
+        REQUIRE( processedSize == content.size() );
+    }
+
+    REQUIRE( fs::file_size( filePath ) == content.size() );
+
+    std::error_code error;
+    fs::remove( filePath, error );
+}
+
+TEST_CASE( "CNativeFileOutStream: Combining small writes and reads", "[nativefilestreams]" ) {
+    const fs::path filePath = unique_temp_path( "bit7z_combined_out_stream" );
+    const buffer_t content = make_content( 1024 * 1024 + 123 );
+
+    // Chunk sizes smaller than the streams' internal buffers, mixed with chunks larger than them.
+    const std::size_t chunkSize = GENERATE( 1, 100, 4096, 70000 );
+
+    {
+        CNativeFileOutStream outStream{ filePath, true };
+        std::size_t offset = 0;
+        std::size_t chunkIndex = 0;
+        while ( offset < content.size() ) {
+            const std::size_t currentChunkSize = ( ++chunkIndex % 8 == 0 ) ? 100000 : chunkSize;
+            const auto writeSize = static_cast< UInt32 >( ( std::min )( currentChunkSize, content.size() - offset ) );
+            UInt32 processedSize = 0;
+            REQUIRE( outStream.Write( &content[ offset ], writeSize, &processedSize ) == S_OK );
+            REQUIRE( processedSize == writeSize );
+            offset += writeSize;
+        }
+
+        // Seeking to the end must account for the still buffered data.
+        UInt64 newPosition = 0;
+        REQUIRE( outStream.Seek( 0, STREAM_SEEK_END, &newPosition ) == S_OK );
+        REQUIRE( newPosition == content.size() );
+
+        // Overwriting some bytes in the middle of the file, then writing again at the end.
+        const buffer_t patch( 10, static_cast< byte_t >( 0xFF ) );
+        UInt32 processedSize = 0;
+        REQUIRE( outStream.Seek( 1000, STREAM_SEEK_SET, &newPosition ) == S_OK );
+        REQUIRE( outStream.Write( patch.data(), static_cast< UInt32 >( patch.size() ), &processedSize ) == S_OK );
+        REQUIRE( outStream.Seek( 0, STREAM_SEEK_END, &newPosition ) == S_OK );
+        REQUIRE( newPosition == content.size() );
+        REQUIRE( outStream.Write( patch.data(), static_cast< UInt32 >( patch.size() ), &processedSize ) == S_OK );
+
+        REQUIRE( outStream.flush() == S_OK );
+        REQUIRE_FALSE( outStream.fail() );
+        REQUIRE( fs::file_size( filePath ) == content.size() + patch.size() );
+    }
+
+    REQUIRE( fs::file_size( filePath ) == content.size() + 10 );
+
+    buffer_t expectedContent = content;
+    std::fill_n( expectedContent.begin() + 1000, 10, static_cast< byte_t >( 0xFF ) );
+    expectedContent.insert( expectedContent.end(), 10, static_cast< byte_t >( 0xFF ) );
+
+    CNativeFileInStream inStream{ filePath };
+    buffer_t readContent( expectedContent.size() );
+    std::size_t offset = 0;
+    while ( offset < readContent.size() ) {
+        const auto readSize = static_cast< UInt32 >( ( std::min )( chunkSize, readContent.size() - offset ) );
+        UInt32 processedSize = 0;
+        REQUIRE( inStream.Read( &readContent[ offset ], readSize, &processedSize ) == S_OK );
+        REQUIRE( processedSize > 0 ); // Reads might be partial, e.g., at the end of the internal buffer.
+        offset += processedSize;
+    }
+    REQUIRE( readContent == expectedContent );
+
+    // Seeking back within the data already read by the stream.
+    UInt64 newPosition = 0;
+    REQUIRE( inStream.Seek( -20, STREAM_SEEK_CUR, &newPosition ) == S_OK );
+    REQUIRE( newPosition == expectedContent.size() - 20 );
+    buffer_t tail( 20 );
+    UInt32 processedSize = 0;
+    REQUIRE( inStream.Read( tail.data(), static_cast< UInt32 >( tail.size() ), &processedSize ) == S_OK );
+    REQUIRE( processedSize == tail.size() );
+    REQUIRE( std::equal( tail.cbegin(), tail.cend(), expectedContent.cend() - 20 ) );
+
+    std::error_code error;
+    fs::remove( filePath, error );
+}
+
+TEST_CASE( "CUnbufferedFileOutStream: Writing a file bypassing the page cache", "[nativefilestreams]" ) {
+    const fs::path filePath = unique_temp_path( "bit7z_unbuffered_out_stream" );
+
+    // Sizes smaller than, multiple of, and not multiple of the alignment, or of the stream's internal buffer.
+    const std::size_t fileSize = GENERATE( 0, 1, 4095, 4096, 1024 * 1024, 3 * 1024 * 1024 + 123 );
+    const buffer_t content = make_content( fileSize );
+    const std::size_t chunkSize = GENERATE( 1000, 65536 );
+    const bool seekBack = GENERATE( false, true );
+
+    {
+        CUnbufferedFileOutStream outStream{ filePath, true };
+        std::size_t offset = 0;
+        while ( offset < content.size() ) {
+            const auto writeSize = static_cast< UInt32 >( ( std::min )( chunkSize, content.size() - offset ) );
+            UInt32 processedSize = 0;
+            REQUIRE( outStream.Write( &content[ offset ], writeSize, &processedSize ) == S_OK );
+            REQUIRE( processedSize == writeSize );
+            offset += writeSize;
+
+            UInt64 newPosition = 0;
+            REQUIRE( outStream.Seek( 0, STREAM_SEEK_CUR, &newPosition ) == S_OK );
+            REQUIRE( newPosition == offset );
+        }
+
+        if ( seekBack && !content.empty() ) {
+            // Non-sequential writes make the stream fall back to the buffered access.
+            UInt64 newPosition = 0;
+            REQUIRE( outStream.Seek( 0, STREAM_SEEK_SET, &newPosition ) == S_OK );
+            REQUIRE( newPosition == 0 );
+            UInt32 processedSize = 0;
+            REQUIRE( outStream.Write( content.data(), 1, &processedSize ) == S_OK );
+            REQUIRE( outStream.Seek( 0, STREAM_SEEK_END, &newPosition ) == S_OK );
+            REQUIRE( newPosition == content.size() );
+        }
+        REQUIRE( outStream.flush() == S_OK );
+        REQUIRE_FALSE( outStream.fail() );
+    }
+
+    REQUIRE( fs::file_size( filePath ) == content.size() );
+
+    CNativeFileInStream inStream{ filePath };
+    buffer_t readContent( content.size() + 1 );
+    UInt32 processedSize = 0;
+    REQUIRE( inStream.Read( readContent.data(), static_cast< UInt32 >( readContent.size() ), &processedSize ) == S_OK );
+    REQUIRE( processedSize == content.size() );
+    REQUIRE( std::equal( content.cbegin(), content.cend(), readContent.cbegin() ) );
+
+    std::error_code error;
+    fs::remove( filePath, error );
+}
+
+TEST_CASE( "CNativeFileInStream: Opening a non-existing file", "[nativefilestreams]" ) {
+    const fs::path filePath = unique_temp_path( "bit7z_non_existing_file" );
+    REQUIRE_THROWS_AS( CNativeFileInStream( filePath ), BitException );
+}
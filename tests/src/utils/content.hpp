@@ -0,0 +1,34 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2023 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CONTENT_HPP
+#define CONTENT_HPP
+
+#include <cstddef>
+
+#include <bit7z/bittypes.hpp>
+
+namespace bit7z { // NOLINT(modernize-concat-nested-namespaces)
+namespace test {
+
+/**
+ * @return a buffer of the given size filled with a non-repeating (within 251 bytes) pattern of bytes.
+ */
+inline auto make_content( std::size_t size ) -> buffer_t {
+    buffer_t content( size );
+    for ( std::size_t i = 0; i < size; ++i ) {
+        content[ i ] = static_cast< byte_t >( i % 251 );
+    }
+    return content;
+}
+
+} // namespace test
+} // namespace bit7z
+
+#endif //CONTENT_HPP
@@ -10,6 +10,10 @@
 #ifndef FILESYSTEM_HPP
 #define FILESYSTEM_HPP
 
+#include <atomic>
+#include <random>
+#include <string>
+
 #include <bit7z/bitfs.hpp>
 #include <bit7z/bittypes.hpp>
 
@@ -49,6 +53,17 @@ inline auto exe_path() -> fs::path {
 #endif
 }
 
+/**
+ * @return a path in the temporary directory that is unique across the test processes, and that starts with the
+ *         given name (so that tests running in parallel don't use the same files or folders).
+ */
+inline auto unique_temp_path( const std::string& name ) -> fs::path {
+    static std::atomic< unsigned > counter{ 0 };
+    std::random_device randomDevice;
+    return fs::temp_directory_path() / ( name + "_" + std::to_string( randomDevice() ) + "_" +
+                                         std::to_string( counter++ ) );
+}
+
 #ifdef BIT7Z_TESTS_DATA_DIR
 
 constexpr auto test_data_dir = BIT7Z_TESTS_DATA_DIR;